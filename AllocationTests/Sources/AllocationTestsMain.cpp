@@ -0,0 +1,246 @@
+// ReSharper disable CppLocalVariableMayBeConst
+// ReSharper disable CppDeprecatedOverridenMethod
+#include <Format/StandardLibraryAdapter.hpp>
+
+#if !FL_COMPILER_IS_GREATER_THAN_CXX11
+#error "Need C++ 11"
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <string>
+#include <vector>
+
+#if FL_PLATFORM_WINDOWS
+#include <malloc.h>
+#endif
+
+using namespace Formatting;
+
+// every heap allocation of the process goes through these replacements,
+// the counters are thread local so the measurement of a thread is not disturbed by the others.
+static thread_local size_t GAllocationCount = 0;
+static thread_local size_t GAllocationBytes = 0;
+
+static void* allocate_no_throw(size_t size)
+{
+    ++GAllocationCount;
+    GAllocationBytes += size;
+
+    return std::malloc(size > 0 ? size : 1);
+}
+
+static void* allocate(size_t size)
+{
+    void* ptr = allocate_no_throw(size);
+
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate_no_throw(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate_no_throw(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+#ifdef __cpp_aligned_new
+// over-aligned types are allocated through these since C++17, they must be counted too
+static void* allocate_aligned_no_throw(size_t size, std::align_val_t alignment)
+{
+    ++GAllocationCount;
+    GAllocationBytes += size;
+
+    const size_t align = static_cast<size_t>(alignment) < sizeof(void*) ? sizeof(void*) : static_cast<size_t>(alignment);
+
+#if FL_PLATFORM_WINDOWS
+    return _aligned_malloc(size > 0 ? size : 1, align);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, align, size > 0 ? size : 1) == 0 ? ptr : nullptr;
+#endif
+}
+
+static void* allocate_aligned(size_t size, std::align_val_t alignment)
+{
+    void* ptr = allocate_aligned_no_throw(size, alignment);
+
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+static void free_aligned(void* ptr)
+{
+#if FL_PLATFORM_WINDOWS
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* operator new(size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate_aligned_no_throw(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate_aligned_no_throw(size, alignment); }
+void operator delete(void* ptr, std::align_val_t) noexcept { free_aligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { free_aligned(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { free_aligned(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { free_aligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { free_aligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { free_aligned(ptr); }
+#endif
+
+struct allocation_result
+{
+    double count_per_call;
+    double bytes_per_call;
+};
+
+template <typename TFunction>
+allocation_result measure(int iterations, TFunction function)
+{
+    // warm up, the first calls fill the pattern cache and grow the reused sinks
+    for (int i = 0; i < 16; ++i)
+    {
+        function(i);
+    }
+
+    const size_t start_count = GAllocationCount;
+    const size_t start_bytes = GAllocationBytes;
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        function(i);
+    }
+
+    allocation_result result;
+    result.count_per_call = static_cast<double>(GAllocationCount - start_count) / iterations;
+    result.bytes_per_call = static_cast<double>(GAllocationBytes - start_bytes) / iterations;
+
+    return result;
+}
+
+static int GFailures = 0;
+
+// max_count < 0 means the case is only reported
+template <typename TFunction>
+void run_case(const char* name, int iterations, double max_count, TFunction function)
+{
+    const allocation_result result = measure(iterations, function);
+    const bool failed = max_count >= 0 && result.count_per_call > max_count;
+
+    if (failed)
+    {
+        ++GFailures;
+    }
+
+    std::cout << "| " << std::left << std::setw(52) << name << " | "
+        << std::right << std::setw(10) << result.count_per_call << " | "
+        << std::setw(10) << result.bytes_per_call << " | "
+        << (max_count < 0 ? "          " : failed ? "FAILED    " : "ok        ") << " |\n";
+}
+
+int main()
+{
+    std::cout << "C++ Version:" << FL_CXX_STANDARD << std::endl;  // NOLINT(performance-avoid-endl)
+
+    FL_CONSTEXPR11 const int iterations = 10000;
+
+    const std::string string_argument = "string argument";
+    const std::string long_string_argument(300, 'x');
+    int pointer_target = 0;
+
+    std::vector<std::string> unique_formats;
+    unique_formats.reserve(iterations + 16);
+
+    for (int i = 0; i < iterations + 16; ++i)
+    {
+        unique_formats.push_back(StandardLibrary::Format("{{0}} {0} {{1}}", i) + " {0} {1}");
+    }
+
+    std::string sink;
+    std::wstring wide_sink;
+    std::string append_sink;
+    append_sink.reserve(4096);
+    TAutoString<char> auto_sink;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "| Case                                                 | Allocs     | Bytes      | Guarantee  |\n";
+    std::cout << "|------------------------------------------------------|------------|------------|------------|\n";
+
+    // steady state with cached patterns and a reused sink, outputs under 120 characters never touch the heap
+    run_case("FormatTo std::string, int", iterations, 0, [&](int i) { StandardLibrary::FormatTo(sink, "value = {0}", i); });
+    run_case("FormatTo std::string, const char*", iterations, 0, [&](int) { StandardLibrary::FormatTo(sink, "value = {0}", "text"); });
+    run_case("FormatTo std::string, std::string", iterations, 0, [&](int) { StandardLibrary::FormatTo(sink, "value = {0}", string_argument); });
+    run_case("FormatTo std::string, double", iterations, 0, [&](int i) { StandardLibrary::FormatTo(sink, "value = {0:f3}", i * 0.25); });
+    run_case("FormatTo std::string, bool and char", iterations, 0, [&](int i) { StandardLibrary::FormatTo(sink, "{0} {1}", (i & 1) != 0, 'c'); });
+    run_case("FormatTo std::string, pointer", iterations, 0, [&](int) { StandardLibrary::FormatTo(sink, "{0}", &pointer_target); });
+    run_case("FormatTo std::string, hex and alignment", iterations, 0, [&](int i) { StandardLibrary::FormatTo(sink, "{0:x8} {1,10} {2,-10}", i, i, "left"); });
+    run_case("FormatTo std::string, six arguments", iterations, 0, [&](int i) { StandardLibrary::FormatTo(sink, "{0} {1} {2} {3} {4} {5}", i, "hello", 1.23, 456, "world", 4.56); });
+    run_case("FormatTo std::wstring, int and const wchar_t*", iterations, 0, [&](int i) { StandardLibrary::FormatTo(wide_sink, L"{0} {1}", i, L"text"); });
+    run_case("FormatTo TAutoString, int", iterations, 0, [&](int i)
+    {
+        auto_sink.Clear();
+        Details::FormatTo<char, Details::StandardLibrary::STLGlobalPatternStorageA>(auto_sink, "value = {0}", i);
+    });
+    run_case("Format short result (SSO), int", iterations, 0, [&](int i) { sink = StandardLibrary::Format("{0}", i % 1000); });
+    run_case("AppendFormat reserved std::string", iterations, 0, [&](int i)
+    {
+        if (append_sink.size() > 4000)
+        {
+            append_sink.clear();
+        }
+
+        StandardLibrary::AppendFormat(append_sink, "{0},", i % 100);
+    });
+    // longer than the stack buffer of TAutoString, the text is still appended in place
+    run_case("AppendFormat long result, reserved std::string", iterations, 0, [&](int i)
+    {
+        if (append_sink.size() > 3800)
+        {
+            append_sink.clear();
+        }
+
+        const size_t start_length = append_sink.size();
+
+        StandardLibrary::AppendFormat(append_sink, "{0:x8} | {1} | {2,-40} | {3,12:f3} | the literal text of this line is long enough for 120 characters\n", i, string_argument, "left aligned", i * 0.5);
+
+        if (append_sink.size() - start_length <= 120)
+        {
+            std::cout << "the AppendFormat result is too short\n";
+            ++GFailures;
+        }
+    });
+    run_case("Lazy not consumed", iterations, 0, [&](int i) { auto message = StandardLibrary::Lazy("{0} {1}", i, string_argument); (void)message; });
+    run_case("FL_STD_FORMAT_TO, int", iterations, 0, [&](int i) { FL_STD_FORMAT_TO(sink, "value = {0}", i); });
+    run_case("Compile handle, int", iterations, 0, [&](int i)
+    {
+        static const auto compiled = StandardLibrary::Compile("value = {0}");
+        StandardLibrary::FormatTo(sink, compiled, i);
+    });
+
+    // reported only, these are expected to allocate
+    run_case("Format long result, std::string", iterations, -1, [&](int) { sink = StandardLibrary::Format("{0}", long_string_argument); });
+    run_case("FormatTo long result, reused std::string", iterations, -1, [&](int) { StandardLibrary::FormatTo(sink, "{0}", long_string_argument); });
+    run_case("Format medium result (not SSO), six arguments", iterations, -1, [&](int i) { sink = StandardLibrary::Format("{0} {1} {2} {3} {4} {5}", i, "hello", 1.23, 456, "world", 4.56); });
+    run_case("FormatTo cache miss, unique formats", iterations, -1, [&](int i) { StandardLibrary::FormatTo(sink, unique_formats[i], i, "miss"); });
+
+    std::cout << "\n" << (GFailures == 0 ? "all allocation guarantees hold" : "allocation guarantees are broken") << "\n";
+
+    return GFailures == 0 ? 0 : 1;
+}
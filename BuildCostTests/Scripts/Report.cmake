@@ -0,0 +1,48 @@
+# prints the build cost table of the generated FormatTo call sites
+# -DBUILD_COST_MANIFEST=<file> -DBUILD_COST_CALL_SITES=<n> [-DBUILD_COST_NM=<nm>]
+cmake_minimum_required(VERSION 3.10)
+
+include(${BUILD_COST_MANIFEST})
+
+set(Report "| Arguments | Signatures | Call Sites | Compile (ms) | Object (bytes) | Symbols | Format Symbols |\n")
+set(Report "${Report}|-----------|------------|------------|--------------|----------------|---------|----------------|\n")
+
+foreach(Entry ${BUILD_COST_ENTRIES})
+    string(REPLACE "|" ";" Fields "${Entry}")
+    list(GET Fields 0 ArgumentCount)
+    list(GET Fields 1 SignatureCount)
+    list(GET Fields 2 Object)
+
+    set(CompileTime "n/a")
+    if(EXISTS "${Object}.time")
+        file(READ "${Object}.time" Elapsed)
+        math(EXPR CompileTime "${Elapsed} / 1000")
+    endif()
+
+    file(SIZE "${Object}" ObjectSize)
+
+    # defined symbols, and the ones that come from the formatting templates
+    set(SymbolCount "n/a")
+    set(FormatSymbolCount "n/a")
+    if(BUILD_COST_NM)
+        execute_process(
+            COMMAND ${BUILD_COST_NM} -C --defined-only "${Object}"
+            OUTPUT_VARIABLE Symbols
+            RESULT_VARIABLE Result
+            ERROR_QUIET
+            )
+
+        if(Result EQUAL 0)
+            string(REGEX MATCHALL "[^\n]+" SymbolLines "${Symbols}")
+            list(LENGTH SymbolLines SymbolCount)
+
+            set(FormatSymbolLines ${SymbolLines})
+            list(FILTER FormatSymbolLines INCLUDE REGEX "Formatting::")
+            list(LENGTH FormatSymbolLines FormatSymbolCount)
+        endif()
+    endif()
+
+    set(Report "${Report}| ${ArgumentCount} | ${SignatureCount} | ${BUILD_COST_CALL_SITES} | ${CompileTime} | ${ObjectSize} | ${SymbolCount} | ${FormatSymbolCount} |\n")
+endforeach()
+
+message("${Report}")
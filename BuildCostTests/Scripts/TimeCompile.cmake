@@ -0,0 +1,52 @@
+# compiler launcher: cmake -P TimeCompile.cmake -- <compiler> <arguments...>
+# runs the compile and writes the elapsed microseconds to <object>.time
+cmake_minimum_required(VERSION 3.10)
+
+set(Command)
+set(Object)
+set(bInCommand FALSE)
+set(bNextIsObject FALSE)
+
+math(EXPR LastArgument "${CMAKE_ARGC} - 1")
+foreach(Index RANGE 0 ${LastArgument})
+    set(Argument "${CMAKE_ARGV${Index}}")
+
+    if(bInCommand)
+        list(APPEND Command "${Argument}")
+
+        if(bNextIsObject)
+            set(Object "${Argument}")
+            set(bNextIsObject FALSE)
+        elseif(Argument STREQUAL "-o")
+            set(bNextIsObject TRUE)
+        elseif(Argument MATCHES "^[/-]Fo(.+)$")
+            set(Object "${CMAKE_MATCH_1}")
+        endif()
+    elseif(Argument STREQUAL "--")
+        set(bInCommand TRUE)
+    endif()
+endforeach()
+
+# %f needs CMake 3.23, older versions measure whole seconds
+if(CMAKE_VERSION VERSION_LESS 3.23)
+    string(TIMESTAMP StartTime "%s000000")
+else()
+    string(TIMESTAMP StartTime "%s%f")
+endif()
+
+execute_process(COMMAND ${Command} RESULT_VARIABLE Result)
+
+if(CMAKE_VERSION VERSION_LESS 3.23)
+    string(TIMESTAMP EndTime "%s000000")
+else()
+    string(TIMESTAMP EndTime "%s%f")
+endif()
+
+if(NOT Result EQUAL 0)
+    message(FATAL_ERROR "compile failed: ${Result}")
+endif()
+
+if(Object)
+    math(EXPR Elapsed "${EndTime} - ${StartTime}")
+    file(WRITE "${Object}.time" "${Elapsed}")
+endif()
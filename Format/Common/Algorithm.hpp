@@ -34,6 +34,11 @@
 
 // ReSharper disable once CppUnusedIncludeDirective
 #include <algorithm>
+#include <cassert>
+
+#if FL_COMPILER_MSVC
+#include <intrin.h>
+#endif
 
 // ReSharper disable once CppEnforceNestedNamespacesStyle
 namespace Formatting // NOLINT(*-concat-nested-namespaces)
@@ -205,5 +210,32 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
         {
             return lhs < rhs ? lhs : rhs;
         }
+
+        /// <summary>
+        /// Counts the trailing zero bits.
+        /// </summary>
+        /// <param name="value">The value, must not be 0.</param>
+        /// <returns>the index of the lowest set bit.</returns>
+        inline uint32_t CountTrailingZeros(const uint32_t value)
+        {
+            assert(value != 0);
+
+#if FL_COMPILER_MSVC
+            unsigned long Index = 0;
+            _BitScanForward(&Index, value);
+
+            return static_cast<uint32_t>(Index);
+#elif FL_COMPILER_GCC
+            return static_cast<uint32_t>(__builtin_ctz(value));
+#else
+            uint32_t Index = 0;
+            while (((value >> Index) & 1) == 0)
+            {
+                ++Index;
+            }
+
+            return Index;
+#endif
+        }
     }
 }
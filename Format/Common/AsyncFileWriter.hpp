@@ -0,0 +1,581 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Common/Build.hpp>
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+#include <Format/Common/Noncopyable.hpp>
+#include <Format/Common/AutoString.hpp>
+#include <Format/Common/FileSink.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Formatting
+{
+    // Allows users to directly define the default buffer character size of TAsyncFileWriter from the outside
+#ifndef FL_DEFAULT_ASYNC_WRITER_BUFFER_LENGTH
+#define FL_DEFAULT_ASYNC_WRITER_BUFFER_LENGTH (32 * 1024)
+#endif
+
+    // Allows users to directly define the default buffer count limit of TAsyncFileWriter from the outside
+#ifndef FL_DEFAULT_ASYNC_WRITER_BUFFER_COUNT
+#define FL_DEFAULT_ASYNC_WRITER_BUFFER_COUNT 16
+#endif
+
+    /// <summary>
+    /// What a producer does when its buffer is full and all buffers are in flight.
+    /// </summary>
+    enum class EBackPressure : uint8_t
+    {
+        Block,  // wait until the writer thread recycles a buffer
+        Drop,   // discard the content of the full buffer and reuse it
+        Grow    // allocate a new buffer, the buffer count limit is ignored
+    };
+
+    /// <summary>
+    /// Class TAsyncFileWriter.
+    /// writes buffers to a FILE* or a file descriptor on a dedicated thread.
+    /// producers format into their own buffers, full buffers are handed to the writer thread through a lock free queue,
+    /// and the writer thread recycles them to a lock free free list after the write.
+    /// all producers must be destroyed before the writer, the writer writes every submitted buffer before it stops.
+    /// Implements the <see cref="Noncopyable" />
+    /// </summary>
+    /// <seealso cref="Noncopyable" />
+    template < typename TCharType >
+    class TAsyncFileWriter : Noncopyable
+    {
+    public:
+        typedef TCharType           CharType;
+
+        struct BufferType : Noncopyable
+        {
+            BufferType() :
+                Next(nullptr),
+                FreeNext(nullptr)
+            {
+            }
+
+            TAutoString<CharType>       Text;
+            std::atomic<BufferType*>    Next;       // link of the submit queue
+            BufferType*                 FreeNext;   // link of the free list
+        };
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TAsyncFileWriter"/> class.
+        /// the file is not owned by the writer.
+        /// </summary>
+        /// <param name="file">The file.</param>
+        /// <param name="policy">The back pressure policy.</param>
+        /// <param name="bufferLength">The buffer length in characters, a buffer is submitted when it reaches this length.</param>
+        /// <param name="bufferCount">The buffer count limit, a producer created when the limit is reached still gets its own buffer.</param>
+        explicit TAsyncFileWriter(
+            FILE* file,
+            const EBackPressure policy = EBackPressure::Block,
+            const size_t bufferLength = FL_DEFAULT_ASYNC_WRITER_BUFFER_LENGTH,
+            const size_t bufferCount = FL_DEFAULT_ASYNC_WRITER_BUFFER_COUNT
+            ) :
+            File(file),
+            FileDescriptor(-1),
+            Policy(policy),
+            BufferLength(bufferLength),
+            BufferCount(bufferCount)
+        {
+            assert(File != nullptr);
+
+            Start();
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TAsyncFileWriter"/> class.
+        /// the file descriptor is not owned by the writer.
+        /// </summary>
+        /// <param name="fileDescriptor">The file descriptor.</param>
+        /// <param name="policy">The back pressure policy.</param>
+        /// <param name="bufferLength">The buffer length in characters, a buffer is submitted when it reaches this length.</param>
+        /// <param name="bufferCount">The buffer count limit, a producer created when the limit is reached still gets its own buffer.</param>
+        explicit TAsyncFileWriter(
+            const int fileDescriptor,
+            const EBackPressure policy = EBackPressure::Block,
+            const size_t bufferLength = FL_DEFAULT_ASYNC_WRITER_BUFFER_LENGTH,
+            const size_t bufferCount = FL_DEFAULT_ASYNC_WRITER_BUFFER_COUNT
+            ) :
+            File(nullptr),
+            FileDescriptor(fileDescriptor),
+            Policy(policy),
+            BufferLength(bufferLength),
+            BufferCount(bufferCount)
+        {
+            assert(FileDescriptor >= 0);
+
+            Start();
+        }
+
+        ~TAsyncFileWriter()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(ConditionMutex);
+                bStopping.store(true);
+            }
+
+            WorkCondition.notify_one();
+
+            WriterThread.join();
+        }
+
+        EBackPressure GetPolicy() const // NOLINT(modernize-use-nodiscard)
+        {
+            return Policy;
+        }
+
+        size_t GetBufferLength() const // NOLINT(modernize-use-nodiscard)
+        {
+            return BufferLength;
+        }
+
+        /// <summary>
+        /// Gets the count of allocated buffers.
+        /// </summary>
+        /// <returns>size_t.</returns>
+        size_t GetAllocatedBufferCount() const // NOLINT(modernize-use-nodiscard)
+        {
+            return AllocatedCount.load();
+        }
+
+        /// <summary>
+        /// Gets the count of characters discarded by the Drop policy.
+        /// </summary>
+        /// <returns>size_t.</returns>
+        size_t GetDroppedLength() const // NOLINT(modernize-use-nodiscard)
+        {
+            return DroppedLength.load();
+        }
+
+        /// <summary>
+        /// Determines whether any write has failed.
+        /// </summary>
+        /// <returns>bool.</returns>
+        bool HasError() const // NOLINT(modernize-use-nodiscard)
+        {
+            return bHasError.load();
+        }
+
+        /// <summary>
+        /// Gets a free buffer, a new buffer is allocated while the limit is not reached.
+        /// </summary>
+        /// <returns>nullptr if all buffers are in flight.</returns>
+        BufferType* TryAcquireBuffer()
+        {
+            // take the whole list, a single exchange has no ABA problem
+            BufferType* List = FreeHead.exchange(nullptr);
+
+            if (List != nullptr)
+            {
+                BufferType* Rest = List->FreeNext;
+
+                if (Rest != nullptr)
+                {
+                    BufferType* Last = Rest;
+
+                    while (Last->FreeNext != nullptr)
+                    {
+                        Last = Last->FreeNext;
+                    }
+
+                    PushFree(Rest, Last);
+                }
+
+                List->FreeNext = nullptr;
+
+                return List;
+            }
+
+            if (AllocatedCount.fetch_add(1) < BufferCount)
+            {
+                return NewBuffer();
+            }
+
+            AllocatedCount.fetch_sub(1);
+
+            return nullptr;
+        }
+
+        /// <summary>
+        /// Gets a free buffer and waits for the writer thread if all buffers are in flight.
+        /// </summary>
+        /// <returns>BufferType*.</returns>
+        BufferType* AcquireBuffer()
+        {
+            for (;;)
+            {
+                // a Recycle after this read changes the version, so the wait below can't miss it
+                size_t Version;
+
+                {
+                    std::lock_guard<std::mutex> Lock(ConditionMutex);
+                    Version = FreeVersion;
+                }
+
+                BufferType* Buffer = TryAcquireBuffer();
+
+                if (Buffer != nullptr)
+                {
+                    return Buffer;
+                }
+
+                std::unique_lock<std::mutex> Lock(ConditionMutex);
+                FreeCondition.wait(Lock, [this, Version]() { return FreeVersion != Version; });
+            }
+        }
+
+        /// <summary>
+        /// Allocates a buffer, the buffer count limit is ignored.
+        /// </summary>
+        /// <returns>BufferType*.</returns>
+        BufferType* AllocateBuffer()
+        {
+            AllocatedCount.fetch_add(1);
+
+            return NewBuffer();
+        }
+
+        /// <summary>
+        /// Hands a buffer to the writer thread.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        void Submit(BufferType* buffer)
+        {
+            assert(buffer != nullptr);
+
+            Push(buffer);
+
+            {
+                std::lock_guard<std::mutex> Lock(ConditionMutex);
+                bWorkPending = true;
+            }
+
+            WorkCondition.notify_one();
+        }
+
+        /// <summary>
+        /// Gives an unused buffer back.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        void Recycle(BufferType* buffer)
+        {
+            buffer->Text.Clear();
+
+            PushFree(buffer, buffer);
+
+            {
+                std::lock_guard<std::mutex> Lock(ConditionMutex);
+                ++FreeVersion;
+            }
+
+            FreeCondition.notify_all();
+        }
+
+        /// <summary>
+        /// Counts the characters discarded by the Drop policy.
+        /// </summary>
+        /// <param name="length">The length.</param>
+        void AddDroppedLength(const size_t length)
+        {
+            DroppedLength.fetch_add(length);
+        }
+
+    private:
+        void Start()
+        {
+            QueueHead.store(&Stub);
+            QueueTail = &Stub;
+            FreeHead.store(nullptr);
+            AllocatedCount.store(0);
+            DroppedLength.store(0);
+            bStopping.store(false);
+            bHasError.store(false);
+            bWorkPending = false;
+            FreeVersion = 0;
+
+            WriterThread = std::thread(&TAsyncFileWriter::Run, this);
+        }
+
+        BufferType* NewBuffer()
+        {
+            std::unique_ptr<BufferType> Buffer(new BufferType());
+
+            // reserve the buffer once, the headroom of Reserve takes the content which crosses the length
+            Buffer->Text.Reserve(BufferLength);
+
+            std::lock_guard<std::mutex> Lock(BuffersMutex);
+
+            Buffers.push_back(std::move(Buffer));
+
+            return Buffers.back().get();
+        }
+
+        void Push(BufferType* buffer)
+        {
+            buffer->Next.store(nullptr);
+
+            BufferType* Previous = QueueHead.exchange(buffer);
+            Previous->Next.store(buffer);
+        }
+
+        void PushFree(BufferType* first, BufferType* last)
+        {
+            BufferType* Expected = FreeHead.load();
+
+            do
+            {
+                last->FreeNext = Expected;
+            } while (!FreeHead.compare_exchange_weak(Expected, first));
+        }
+
+        /// <summary>
+        /// Pops a submitted buffer, only the writer thread calls this.
+        /// this is an intrusive multiple producer single consumer queue with a stub node.
+        /// </summary>
+        /// <returns>nullptr if the queue is empty or a producer is in the middle of Submit.</returns>
+        BufferType* Pop()
+        {
+            BufferType* Tail = QueueTail;
+            BufferType* Next = Tail->Next.load();
+
+            if (Tail == &Stub)
+            {
+                if (Next == nullptr)
+                {
+                    return nullptr;
+                }
+
+                QueueTail = Next;
+                Tail = Next;
+                Next = Next->Next.load();
+            }
+
+            if (Next != nullptr)
+            {
+                QueueTail = Next;
+
+                return Tail;
+            }
+
+            if (Tail != QueueHead.load())
+            {
+                return nullptr;
+            }
+
+            Push(&Stub);
+
+            Next = Tail->Next.load();
+
+            if (Next != nullptr)
+            {
+                QueueTail = Next;
+
+                return Tail;
+            }
+
+            return nullptr;
+        }
+
+        void Run()
+        {
+            for (;;)
+            {
+                BufferType* Buffer = Pop();
+
+                if (Buffer != nullptr)
+                {
+                    const char* Data = reinterpret_cast<const char*>(Buffer->Text.CStr());
+                    const size_t Bytes = Buffer->Text.GetLength() * sizeof(CharType);
+
+                    if (!(File != nullptr ? Details::WriteToFile(File, Data, Bytes) : Details::WriteToFileDescriptor(FileDescriptor, Data, Bytes)))
+                    {
+                        bHasError.store(true);
+                    }
+
+                    Recycle(Buffer);
+
+                    continue;
+                }
+
+                if (bStopping.load())
+                {
+                    // all producers are gone, so an empty queue stays empty
+                    break;
+                }
+
+                // Submit sets the flag after the buffer is linked, a producer in the middle of Submit wakes us when it is done
+                std::unique_lock<std::mutex> Lock(ConditionMutex);
+                WorkCondition.wait(Lock, [this]() { return bWorkPending || bStopping.load(); });
+                bWorkPending = false;
+            }
+        }
+
+    private:
+        FILE*                                       File;
+        int                                         FileDescriptor;
+        EBackPressure                               Policy;
+        size_t                                      BufferLength;
+        size_t                                      BufferCount;
+
+        BufferType                                  Stub;
+        std::atomic<BufferType*>                    QueueHead;
+        BufferType*                                 QueueTail;
+        std::atomic<BufferType*>                    FreeHead;
+
+        std::atomic<size_t>                         AllocatedCount;
+        std::atomic<size_t>                         DroppedLength;
+        std::atomic<bool>                           bStopping;
+        std::atomic<bool>                           bHasError;
+
+        std::mutex                                  ConditionMutex;
+        bool                                        bWorkPending;
+        size_t                                      FreeVersion;
+        std::condition_variable                     WorkCondition;
+        std::condition_variable                     FreeCondition;
+
+        std::mutex                                  BuffersMutex;
+        std::vector< std::unique_ptr<BufferType> >  Buffers;
+
+        std::thread                                 WriterThread;
+    };
+
+    /// <summary>
+    /// Class TAsyncFileProducer.
+    /// the buffer of one thread for a TAsyncFileWriter, it must be used by one thread only.
+    /// the content is formatted into the buffer in place, the buffer is submitted when it is full.
+    /// Implements the <see cref="Noncopyable" />
+    /// </summary>
+    /// <seealso cref="Noncopyable" />
+    template < typename TCharType >
+    class TAsyncFileProducer : Noncopyable
+    {
+    public:
+        typedef TCharType                                   CharType;
+        typedef TAsyncFileWriter<CharType>                  WriterType;
+        typedef typename WriterType::BufferType             BufferType;
+
+        explicit TAsyncFileProducer(WriterType& writer) :
+            Writer(writer),
+            Buffer(writer.TryAcquireBuffer())
+        {
+            if (Buffer == nullptr)
+            {
+                // a producer always owns a buffer
+                Buffer = Writer.AllocateBuffer();
+            }
+        }
+
+        ~TAsyncFileProducer()
+        {
+            if (Buffer->Text.IsEmpty())
+            {
+                Writer.Recycle(Buffer);
+            }
+            else
+            {
+                Writer.Submit(Buffer);
+            }
+        }
+
+        /// <summary>
+        /// Gets the buffer, formatted content is appended to it in place.
+        /// call SubmitIfFull after the content is appended.
+        /// </summary>
+        /// <returns>TAutoString&lt;CharType&gt; &.</returns>
+        TAutoString<CharType>& GetBuffer()
+        {
+            return Buffer->Text;
+        }
+
+        /// <summary>
+        /// Submits the buffer if it reaches the buffer length.
+        /// </summary>
+        void SubmitIfFull()
+        {
+            if (Buffer->Text.GetLength() < Writer.GetBufferLength())
+            {
+                return;
+            }
+
+            BufferType* NextBuffer = Writer.TryAcquireBuffer();
+
+            if (NextBuffer == nullptr)
+            {
+                switch (Writer.GetPolicy())
+                {
+                case EBackPressure::Drop:
+                    Writer.AddDroppedLength(Buffer->Text.GetLength());
+                    Buffer->Text.Clear();
+                    return;
+                case EBackPressure::Grow:
+                    NextBuffer = Writer.AllocateBuffer();
+                    break;
+                default:
+                    // submit before waiting, so the writer thread always has a buffer to recycle
+                    Writer.Submit(Buffer);
+                    Buffer = Writer.AcquireBuffer();
+                    return;
+                }
+            }
+
+            Writer.Submit(Buffer);
+            Buffer = NextBuffer;
+        }
+
+        /// <summary>
+        /// Submits the buffer even if it is not full, it never drops the content.
+        /// </summary>
+        void Flush()
+        {
+            if (Buffer->Text.IsEmpty())
+            {
+                return;
+            }
+
+            Writer.Submit(Buffer);
+
+            Buffer = Writer.TryAcquireBuffer();
+
+            if (Buffer == nullptr)
+            {
+                Buffer = Writer.GetPolicy() == EBackPressure::Grow ? Writer.AllocateBuffer() : Writer.AcquireBuffer();
+            }
+        }
+
+    private:
+        WriterType&     Writer;
+        BufferType*     Buffer;
+    };
+}
+#endif
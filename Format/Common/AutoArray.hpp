@@ -361,6 +361,24 @@ namespace Formatting
             return GetDataPtr()[index];
         }
 
+        /// <summary>
+        /// Removes the last item.
+        /// </summary>
+        void RemoveLast()
+        {
+            assert(Count > 0);
+
+            --Count;
+        }
+
+        /// <summary>
+        /// Removes all items, the heap memory is kept for reuse.
+        /// </summary>
+        void Clear()
+        {
+            Count = 0;
+        }
+
         void Shrink()
 		{
 		    if(AllocatedCount <= Count || HeapValPtr == nullptr)
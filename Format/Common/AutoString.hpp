@@ -126,7 +126,7 @@ namespace Formatting
             {
                 if (NewCount <= DEFAULT_LENGTH)
                 {
-                    CharTraits::copy(StackVal + Count, str, length);
+                    CharTraits::Copy(StackVal + Count, str, length);
                     Count = NewCount;
 
                     StackVal[Count] = 0;
@@ -144,7 +144,7 @@ namespace Formatting
                         CharTraits::copy(HeapValPtr, StackVal, Count);
                     }
 
-                    CharTraits::copy(HeapValPtr + Count, str, length);
+                    CharTraits::Copy(HeapValPtr + Count, str, length);
                     Count = NewCount;
 
                     HeapValPtr[Count] = 0;
@@ -154,7 +154,7 @@ namespace Formatting
             {
                 if (NewCount <= AllocatedCount)
                 {
-                    CharTraits::copy(HeapValPtr + Count, str, length);                    
+                    CharTraits::Copy(HeapValPtr + Count, str, length);                    
                     Count = NewCount;
 
                     HeapValPtr[Count] = 0;
@@ -174,7 +174,7 @@ namespace Formatting
 
                     assert(HeapValPtr == nullptr);
 
-                    CharTraits::copy(DataPtr + Count, str, length);
+                    CharTraits::Copy(DataPtr + Count, str, length);
 
                     Count = NewCount;
 
@@ -186,47 +186,68 @@ namespace Formatting
             }
         }
 
-    private:
-        void AppendWithPadding(
-            CharType* bufferPtr,
-            const CharType* start,
-            const size_t length,
-            const size_t targetLength,
-            const bool paddingLeft,
-            const CharType fillChar
-            )
+        /// <summary>
+        /// Reserves space for length characters at the end and returns the write position.
+        /// nothing is added until Commit is called, so the content can be written in place without a temporary buffer.
+        /// the returned pointer is invalidated by any other modification.
+        /// </summary>
+        /// <param name="length">The maximum length will be written.</param>
+        /// <returns>CharType*.</returns>
+        CharType* Reserve(const size_t length)
         {
-            assert(bufferPtr != nullptr);
-
-            const int PaddingCount = static_cast<int>(targetLength - length);
-            CharType* const StartPos = bufferPtr + Count;
-            
-            assert(bufferPtr);
-            assert(start);            
+            const size_t NewCount = Count + length;
 
-            if (PaddingCount > 0)
+            if (IsDataOnStack())
             {
-                if (paddingLeft)
+                if (NewCount <= DEFAULT_LENGTH)
                 {
-                    CharTraits::Fill(StartPos, fillChar, PaddingCount);
-                    CharTraits::copy(StartPos + PaddingCount, start, length);
+                    return StackVal + Count;
                 }
-                else
+
+                assert(!HeapValPtr);
+
+                AllocatedCount = NewCount + NewCount/2;
+                HeapValPtr = Allocate(AllocatedCount);
+                assert(HeapValPtr);
+
+                if (Count > 0)
                 {
-                    CharTraits::copy(StartPos, start, length);
-                    CharTraits::Fill(StartPos + length, fillChar, PaddingCount);
+                    CharTraits::copy(HeapValPtr, StackVal, Count);
                 }
             }
-            else
+            else if (NewCount > AllocatedCount)
             {
-                CharTraits::copy(StartPos, start, length);                
+                const size_t NewAllocatedCount = NewCount + NewCount/2;
+                CharType* DataPtr = Allocate(NewAllocatedCount);
+                assert(DataPtr);
+
+                if (Count > 0)
+                {
+                    CharTraits::copy(DataPtr, HeapValPtr, Count);
+                }
+
+                ReleaseHeapData();
+
+                AllocatedCount = NewAllocatedCount;
+                HeapValPtr = DataPtr;
             }
 
-            Count += targetLength;
-            bufferPtr[Count] = TCharTraits<CharType>::GetEndFlag();
+            return HeapValPtr + Count;
+        }
+
+        /// <summary>
+        /// Commits the characters written to the position returned by Reserve.
+        /// </summary>
+        /// <param name="length">The written length, it can't be greater than the reserved length.</param>
+        void Commit(const size_t length)
+        {
+            Count += length;
+
+            assert(IsDataOnStack() ? (Count <= DEFAULT_LENGTH) : (Count <= AllocatedCount)); // NOLINT
+
+            GetDataPtr()[Count] = TCharTraits<CharType>::GetEndFlag();
         }
 
-    public:
         void AddAlignStr(
             const CharType* start,
             const size_t length,
@@ -235,56 +256,32 @@ namespace Formatting
             const CharType fillChar)
         {
             // get text length
-            const size_t TargetLength = Algorithm::Max(length, static_cast<size_t>(alignedLength));            
-            const size_t NewCount = Count + TargetLength;
-            
-            if (IsDataOnStack())
+            const size_t TargetLength = Algorithm::Max(length, static_cast<size_t>(alignedLength));
+            const size_t PaddingCount = TargetLength - length;
+
+            assert(start);
+
+            CharType* const StartPos = Reserve(TargetLength);
+
+            if (PaddingCount > 0)
             {
-                if (NewCount <= DEFAULT_LENGTH)
+                if (paddingLeft)
                 {
-                    AppendWithPadding(StackVal, start, length, TargetLength, paddingLeft, fillChar);
+                    CharTraits::Fill(StartPos, fillChar, PaddingCount);
+                    CharTraits::Copy(StartPos + PaddingCount, start, length);
                 }
                 else
                 {
-                    assert(!HeapValPtr);
-                    AllocatedCount = NewCount + NewCount/2; 
-                    HeapValPtr = Allocate(AllocatedCount);
-
-                    assert(HeapValPtr);
-
-                    if (Count > 0)
-                    {
-                        CharTraits::copy(HeapValPtr, StackVal, Count);
-                    }
-                    
-                    AppendWithPadding(HeapValPtr, start, length, TargetLength, paddingLeft, fillChar);                    
+                    CharTraits::Copy(StartPos, start, length);
+                    CharTraits::Fill(StartPos + length, fillChar, PaddingCount);
                 }
             }
             else
             {
-                if (NewCount < AllocatedCount)
-                {
-                    AppendWithPadding(HeapValPtr, start, length, TargetLength, paddingLeft, fillChar);
-                }
-                else
-                {
-                    const size_t NewAllocatedCount = NewCount + NewCount/2;
-                    CharType* DataPtr = Allocate(NewAllocatedCount);
-                    assert(DataPtr);
-
-                    if (Count > 0)
-                    {
-                        CharTraits::copy(DataPtr, HeapValPtr, Count);
-                    }
-
-                    ReleaseHeapData();
-
-                    AllocatedCount = NewAllocatedCount;
-                    HeapValPtr = DataPtr;
-
-                    AppendWithPadding(HeapValPtr, start, length, TargetLength, paddingLeft, fillChar);
-                }
+                CharTraits::Copy(StartPos, start, length);
             }
+
+            Commit(TargetLength);
         }
 
         const TCharType* CStr() const  // NOLINT(modernize-use-nodiscard)
@@ -98,6 +98,15 @@
 #define FL_PLATFORM_ARM       0
 #endif
 
+// SIMD kernels, define it as 0 before include this file to disable them
+#ifndef FL_WITH_SSE2
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FL_WITH_SSE2          1
+#else
+#define FL_WITH_SSE2          0
+#endif
+#endif
+
 #if defined(DEBUG)||defined(_DEBUG)
 #define FL_DEBUG              1
 #else
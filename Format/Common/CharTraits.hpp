@@ -30,15 +30,167 @@
 #include <cstdarg>
 #include <string>
 #include <cstring>
+#include <cctype>
+#include <cwctype>
 
 #include <Format/Common/Build.hpp>
 
+#if FL_WITH_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Formatting
 {
+    namespace Details
+    {
+        // pads and segments up to this length are written with a plain loop, without library calls
+#ifndef FL_SHORT_FILL_LENGTH
+#define FL_SHORT_FILL_LENGTH 16
+#endif
+
+#if FL_WITH_SSE2
+        template <size_t Size>
+        struct TSimdCharLanes;
+
+        template <>
+        struct TSimdCharLanes<1>
+        {
+            template <typename TCharType>
+            static __m128i Splat(const TCharType value)
+            {
+                return _mm_set1_epi8(static_cast<char>(value));
+            }
+
+            static __m128i Equal(const __m128i left, const __m128i right)
+            {
+                return _mm_cmpeq_epi8(left, right);
+            }
+        };
+
+        template <>
+        struct TSimdCharLanes<2>
+        {
+            template <typename TCharType>
+            static __m128i Splat(const TCharType value)
+            {
+                return _mm_set1_epi16(static_cast<short>(value));
+            }
+
+            static __m128i Equal(const __m128i left, const __m128i right)
+            {
+                return _mm_cmpeq_epi16(left, right);
+            }
+        };
+
+        template <>
+        struct TSimdCharLanes<4>
+        {
+            template <typename TCharType>
+            static __m128i Splat(const TCharType value)
+            {
+                return _mm_set1_epi32(static_cast<int>(value));
+            }
+
+            static __m128i Equal(const __m128i left, const __m128i right)
+            {
+                return _mm_cmpeq_epi32(left, right);
+            }
+        };
+#endif
+
+        /// <summary>
+        /// Fills characters.
+        /// short pads are written directly, long pads of 1 byte characters use memset,
+        /// other characters are stored 16 bytes per step when SSE2 is available.
+        /// </summary>
+        /// <param name="dest">The dest.</param>
+        /// <param name="value">The value.</param>
+        /// <param name="length">The length.</param>
+        /// <returns>dest</returns>
+        template <typename TCharType>
+        inline TCharType* FillCharacters(TCharType* const dest, const TCharType value, const size_t length)
+        {
+            if (length <= FL_SHORT_FILL_LENGTH)
+            {
+                for (size_t i = 0; i < length; ++i)
+                {
+                    dest[i] = value;
+                }
+
+                return dest;
+            }
+
+            if (sizeof(TCharType) == 1)
+            {
+                memset(dest, static_cast<unsigned char>(value), length);
+
+                return dest;
+            }
+
+#if FL_WITH_SSE2
+            const size_t LaneCount = sizeof(__m128i) / sizeof(TCharType);
+            const __m128i Lanes = TSimdCharLanes<sizeof(TCharType)>::Splat(value);
+
+            size_t Index = 0;
+            for (; Index + LaneCount <= length; Index += LaneCount)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + Index), Lanes);
+            }
+
+            // the tail overlaps the last full store
+            if (Index < length)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + length - LaneCount), Lanes);
+            }
+#else
+            for (size_t i = 0; i < length; ++i)
+            {
+                dest[i] = value;
+            }
+#endif
+
+            return dest;
+        }
+
+        /// <summary>
+        /// Copies characters, the ranges must not overlap.
+        /// short segments are copied directly, long segments use the standard copy, which is vectorized by the C library already.
+        /// </summary>
+        /// <param name="dest">The dest.</param>
+        /// <param name="source">The source.</param>
+        /// <param name="length">The length.</param>
+        /// <returns>dest</returns>
+        template <typename TCharType>
+        inline TCharType* CopyCharacters(TCharType* const dest, const TCharType* const source, const size_t length)
+        {
+            if (length <= FL_SHORT_FILL_LENGTH)
+            {
+                for (size_t i = 0; i < length; ++i)
+                {
+                    dest[i] = source[i];
+                }
+
+                return dest;
+            }
+
+            return std::char_traits<TCharType>::copy(dest, source, length);
+        }
+    }
+
     template < typename TCharType >
     class TCharTraits :
         public std::char_traits<TCharType>
     {
+    public:
+        static TCharType* Fill(TCharType* dest, const TCharType val, const size_t length)
+        {
+            return Details::FillCharacters(dest, val, length);
+        }
+
+        static TCharType* Copy(TCharType* dest, const TCharType* source, const size_t length)
+        {
+            return Details::CopyCharacters(dest, source, length);
+        }
     };
 
     // ReSharper disable once CppRedundantAccessSpecifier
@@ -232,7 +384,12 @@ namespace Formatting
 
         static char* Fill(char* dest, const char val, const size_t length)
         {
-            return (char*)memset(dest, val, length); // NOLINT
+            return Details::FillCharacters(dest, val, length);
+        }
+
+        static char* Copy(char* dest, const char* source, const size_t length)
+        {
+            return Details::CopyCharacters(dest, source, length);
         }
 
         // ReSharper disable once CommentTypo
@@ -523,7 +680,12 @@ namespace Formatting
 
         static wchar_t* Fill(wchar_t* dest, const wchar_t val, const size_t length)
         {
-            return wmemset(dest, val, length);
+            return Details::FillCharacters(dest, val, length);
+        }
+
+        static wchar_t* Copy(wchar_t* dest, const wchar_t* source, const size_t length)
+        {
+            return Details::CopyCharacters(dest, source, length);
         }
 
         static int IsAlnum(const wchar_t ch) // NOLINT
@@ -0,0 +1,209 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Common/Build.hpp>
+#include <Format/Common/Noncopyable.hpp>
+#include <Format/Common/AutoArray.hpp>
+#include <Format/Common/CharTraits.hpp>
+#include <Format/Common/Algorithm.hpp>
+#include <cstdio>
+
+namespace Formatting
+{
+    // Allows users to directly define the default TChunkedString block character size from the outside
+#ifndef FL_DEFAULT_CHUNKED_STRING_BLOCK_LENGTH
+#define FL_DEFAULT_CHUNKED_STRING_BLOCK_LENGTH (16 * 1024)
+#endif
+
+    /// <summary>
+    /// Class TChunkedString.
+    /// a string stored in fixed size blocks, appending never moves the content written before.
+    /// a huge output built from many small appends is copied once and the peak memory is the content plus one block.
+    /// FormatTo copies the literal text of the format straight into the blocks and stages only the output of one placeholder at a time,
+    /// so the peak memory of a call is the content plus one block plus its largest placeholder.
+    /// the blocks are kept by Clear and reused by the next content.
+    /// Implements the <see cref="Noncopyable" />
+    /// </summary>
+    /// <seealso cref="Noncopyable" />
+    template < typename TCharType >
+    class TChunkedString : Noncopyable
+    {
+    public:
+        typedef TCharType                       CharType;
+        typedef TCharTraits<CharType>           CharTraits;
+        typedef TAutoArray<CharType*, 0x10, 0>  BlockListType;
+
+        explicit TChunkedString(const size_t blockLength = FL_DEFAULT_CHUNKED_STRING_BLOCK_LENGTH) :
+            BlockLength(blockLength > 0 ? blockLength : 1),
+            Length(0)
+        {
+        }
+
+        ~TChunkedString()
+        {
+            for (size_t i = 0; i < Blocks.GetLength(); ++i)
+            {
+                delete[] Blocks[i];
+            }
+        }
+
+        /// <summary>
+        /// Appends a string.
+        /// </summary>
+        /// <param name="str">The string.</param>
+        /// <param name="length">The length.</param>
+        void AddStr(const CharType* str, size_t length)
+        {
+            assert(str != nullptr || length == 0);
+
+            while (length > 0)
+            {
+                const size_t Offset = Length % BlockLength;
+                const size_t BlockIndex = Length / BlockLength;
+
+                if (BlockIndex == Blocks.GetLength())
+                {
+                    Blocks.AddItem(new CharType[BlockLength]);
+                }
+
+                const size_t CopyLength = Algorithm::Min(length, BlockLength - Offset);
+
+                CharTraits::Copy(Blocks[BlockIndex] + Offset, str, CopyLength);
+
+                str += CopyLength;
+                length -= CopyLength;
+                Length += CopyLength;
+            }
+        }
+
+        /// <summary>
+        /// Allocates the blocks for length more characters, so the next appends don't allocate.
+        /// </summary>
+        /// <param name="length">The length.</param>
+        void Reserve(const size_t length)
+        {
+            const size_t BlockCount = (Length + length + BlockLength - 1) / BlockLength;
+
+            while (Blocks.GetLength() < BlockCount)
+            {
+                Blocks.AddItem(new CharType[BlockLength]);
+            }
+        }
+
+        /// <summary>
+        /// Gets the length.
+        /// </summary>
+        /// <returns>size_t.</returns>
+        size_t GetLength() const // NOLINT(modernize-use-nodiscard)
+        {
+            return Length;
+        }
+
+        bool IsEmpty() const // NOLINT(modernize-use-nodiscard)
+        {
+            return Length == 0;
+        }
+
+        /// <summary>
+        /// Gets the count of the blocks which hold content.
+        /// </summary>
+        /// <returns>size_t.</returns>
+        size_t GetBlockCount() const // NOLINT(modernize-use-nodiscard)
+        {
+            return (Length + BlockLength - 1) / BlockLength;
+        }
+
+        /// <summary>
+        /// Gets the content of a block, it is not null terminated.
+        /// </summary>
+        /// <param name="index">The index.</param>
+        /// <returns>const CharType*.</returns>
+        const CharType* GetBlockData(const size_t index) const // NOLINT(modernize-use-nodiscard)
+        {
+            assert(index < GetBlockCount());
+
+            return Blocks[index];
+        }
+
+        /// <summary>
+        /// Gets the content length of a block, only the last block may be partly filled.
+        /// </summary>
+        /// <param name="index">The index.</param>
+        /// <returns>size_t.</returns>
+        size_t GetBlockLength(const size_t index) const // NOLINT(modernize-use-nodiscard)
+        {
+            assert(index < GetBlockCount());
+
+            return index + 1 < GetBlockCount() ? BlockLength : Length - index * BlockLength;
+        }
+
+        /// <summary>
+        /// Gathers all content to a buffer, the buffer must have space for GetLength() characters.
+        /// no terminator is written.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        void CopyTo(CharType* buffer) const
+        {
+            for (size_t i = 0; i < GetBlockCount(); ++i)
+            {
+                CharTraits::Copy(buffer, GetBlockData(i), GetBlockLength(i));
+
+                buffer += GetBlockLength(i);
+            }
+        }
+
+        /// <summary>
+        /// Writes all content to a file block by block, no encoding conversion is done.
+        /// </summary>
+        /// <param name="file">The file.</param>
+        /// <returns>false if the file reports an error.</returns>
+        bool WriteTo(FILE* file) const
+        {
+            assert(file != nullptr);
+
+            for (size_t i = 0; i < GetBlockCount(); ++i)
+            {
+                if (fwrite(GetBlockData(i), sizeof(CharType), GetBlockLength(i), file) != GetBlockLength(i))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void Clear()
+        {
+            Length = 0;
+        }
+
+    private:
+        BlockListType       Blocks;
+        size_t              BlockLength;
+        size_t              Length;
+    };
+}
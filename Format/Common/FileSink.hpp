@@ -0,0 +1,240 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Common/Build.hpp>
+#include <Format/Common/Noncopyable.hpp>
+#include <Format/Common/AutoString.hpp>
+#include <cstdio>
+#include <cerrno>
+
+#if FL_PLATFORM_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Formatting
+{
+    // Allows users to directly define the default TFileSink buffer character size from the outside
+#ifndef FL_DEFAULT_FILE_SINK_BUFFER_LENGTH
+#define FL_DEFAULT_FILE_SINK_BUFFER_LENGTH (64 * 1024)
+#endif
+
+    namespace Details
+    {
+        /// <summary>
+        /// Writes bytes to a FILE* and flushes it.
+        /// </summary>
+        /// <param name="file">The file.</param>
+        /// <param name="data">The data.</param>
+        /// <param name="bytes">The bytes.</param>
+        /// <returns>false if the file reports an error.</returns>
+        inline bool WriteToFile(FILE* file, const char* data, const size_t bytes)
+        {
+            return fwrite(data, 1, bytes, file) == bytes && fflush(file) == 0;
+        }
+
+        /// <summary>
+        /// Writes all bytes to a file descriptor, partial writes and interrupts are continued.
+        /// </summary>
+        /// <param name="fileDescriptor">The file descriptor.</param>
+        /// <param name="data">The data.</param>
+        /// <param name="bytes">The bytes.</param>
+        /// <returns>false if the write fails.</returns>
+        inline bool WriteToFileDescriptor(const int fileDescriptor, const char* data, size_t bytes)
+        {
+            while (bytes > 0)
+            {
+#if FL_PLATFORM_WINDOWS
+                const int Written = ::_write(fileDescriptor, data, static_cast<unsigned>(bytes));
+#else
+                const ssize_t Written = ::write(fileDescriptor, data, bytes);
+#endif
+
+                if (Written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return false;
+                }
+
+                data += Written;
+                bytes -= static_cast<size_t>(Written);
+            }
+
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Class TFileSink.
+    /// buffered output to a FILE* or a file descriptor.
+    /// the formatting engine writes directly into the buffer, the buffer is written to the target
+    /// only when it is full or Flush is called, so a full buffer costs one write call.
+    /// the content is written as raw TCharType units, no encoding conversion is done.
+    /// Implements the <see cref="Noncopyable" />
+    /// </summary>
+    /// <seealso cref="Noncopyable" />
+    template < typename TCharType >
+    class TFileSink : Noncopyable
+    {
+    public:
+        typedef TAutoString<TCharType>          BufferType;
+        typedef TCharType                       CharType;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TFileSink"/> class.
+        /// the file is not owned by the sink.
+        /// </summary>
+        /// <param name="file">The file.</param>
+        /// <param name="bufferLength">Length of the buffer in characters.</param>
+        explicit TFileSink(FILE* file, const size_t bufferLength = FL_DEFAULT_FILE_SINK_BUFFER_LENGTH) :
+            File(file),
+            FileDescriptor(-1),
+            BufferLength(bufferLength),
+            bHasError(false)
+        {
+            assert(File != nullptr);
+
+            InitializeBuffer();
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TFileSink"/> class.
+        /// the file descriptor is not owned by the sink.
+        /// </summary>
+        /// <param name="fileDescriptor">The file descriptor.</param>
+        /// <param name="bufferLength">Length of the buffer in characters.</param>
+        explicit TFileSink(const int fileDescriptor, const size_t bufferLength = FL_DEFAULT_FILE_SINK_BUFFER_LENGTH) :
+            File(nullptr),
+            FileDescriptor(fileDescriptor),
+            BufferLength(bufferLength),
+            bHasError(false)
+        {
+            assert(FileDescriptor >= 0);
+
+            InitializeBuffer();
+        }
+
+        ~TFileSink()
+        {
+            Flush();
+        }
+
+        /// <summary>
+        /// Gets the buffer, formatted content is appended to it in place.
+        /// call FlushIfFull after the content is appended.
+        /// </summary>
+        /// <returns>BufferType &.</returns>
+        BufferType& GetBuffer()
+        {
+            return Buffer;
+        }
+
+        /// <summary>
+        /// Writes the buffer to the target if the buffered content reaches the buffer length.
+        /// </summary>
+        void FlushIfFull()
+        {
+            if (Buffer.GetLength() >= BufferLength)
+            {
+                Flush();
+            }
+        }
+
+        /// <summary>
+        /// Appends a string without formatting.
+        /// </summary>
+        /// <param name="str">The string.</param>
+        /// <param name="length">The length.</param>
+        void Write(const CharType* str, const size_t length)
+        {
+            Buffer.AddStr(str, length);
+
+            FlushIfFull();
+        }
+
+        /// <summary>
+        /// Writes all buffered content to the target.
+        /// </summary>
+        /// <returns>false if the target reports an error.</returns>
+        bool Flush()
+        {
+            if (!Buffer.IsEmpty())
+            {
+                const char* Data = reinterpret_cast<const char*>(Buffer.CStr());
+                const size_t Bytes = Buffer.GetLength() * sizeof(CharType);
+
+                if (!(File != nullptr ? Details::WriteToFile(File, Data, Bytes) : Details::WriteToFileDescriptor(FileDescriptor, Data, Bytes)))
+                {
+                    bHasError = true;
+                }
+
+                // the heap buffer is kept by Clear, it is reused by the next content
+                Buffer.Clear();
+            }
+
+            return !bHasError;
+        }
+
+        /// <summary>
+        /// Determines whether any write has failed.
+        /// </summary>
+        /// <returns>bool.</returns>
+        bool HasError() const // NOLINT(modernize-use-nodiscard)
+        {
+            return bHasError;
+        }
+
+        /// <summary>
+        /// Gets the buffer length in characters.
+        /// </summary>
+        /// <returns>size_t.</returns>
+        size_t GetBufferLength() const // NOLINT(modernize-use-nodiscard)
+        {
+            return BufferLength;
+        }
+
+    private:
+        void InitializeBuffer()
+        {
+            // allocate the heap buffer up front, the extra half of Reserve is kept as headroom
+            // for the content which crosses the buffer length, so the buffer never grows in practice.
+            Buffer.Reserve(BufferLength);
+        }
+
+    private:
+        BufferType      Buffer;
+        FILE*           File;
+        int             FileDescriptor;
+        size_t          BufferLength;
+        bool            bHasError;
+    };
+}
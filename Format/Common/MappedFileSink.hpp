@@ -0,0 +1,300 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Common/Build.hpp>
+#include <Format/Common/Noncopyable.hpp>
+#include <Format/Common/Mutex.hpp>
+
+// the sink needs std::atomic and the posix mmap api
+#if FL_COMPILER_IS_GREATER_THAN_CXX11 && !FL_PLATFORM_WINDOWS
+#define FL_WITH_MAPPED_FILE_SINK 1
+#else
+#define FL_WITH_MAPPED_FILE_SINK 0
+#endif
+
+#if FL_WITH_MAPPED_FILE_SINK
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace Formatting
+{
+    // Allows users to directly define the default TMappedFileSink chunk size from the outside
+#ifndef FL_DEFAULT_MAPPED_FILE_CHUNK_SIZE
+#define FL_DEFAULT_MAPPED_FILE_CHUNK_SIZE (64 * 1024 * 1024)
+#endif
+
+    /// <summary>
+    /// Class TMappedFileSink.
+    /// an append only file sink which can be written by many threads without a lock.
+    /// the file is mapped in chunks, a writer reserves its range with one fetch_add on the write offset of
+    /// the current chunk and copies its content into the mapped memory.
+    /// when a reservation crosses the end of the chunk, the next chunk is mapped right after the last complete
+    /// write, the old chunk is unmapped after its last writer has finished.
+    /// the file is truncated to the written length when the sink is destroyed.
+    /// Implements the <see cref="Noncopyable" />
+    /// </summary>
+    /// <seealso cref="Noncopyable" />
+    template < typename TCharType >
+    class TMappedFileSink : Noncopyable
+    {
+    public:
+        typedef TCharType           CharType;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TMappedFileSink"/> class.
+        /// the content is appended to the end of the file.
+        /// </summary>
+        /// <param name="path">The file path.</param>
+        /// <param name="chunkSize">Size of the mapped chunks in bytes.</param>
+        explicit TMappedFileSink(const char* path, const size_t chunkSize = FL_DEFAULT_MAPPED_FILE_CHUNK_SIZE) :
+            FileDescriptor(-1),
+            PageSize(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+            ChunkSize(0),
+            Current(nullptr)
+        {
+            assert(path != nullptr);
+
+            ChunkSize = AlignToPage(chunkSize > 0 ? chunkSize : 1);
+
+            FileDescriptor = open(path, O_RDWR | O_CREAT, 0644);
+
+            struct stat FileStat; // NOLINT
+
+            if (FileDescriptor < 0 || fstat(FileDescriptor, &FileStat) != 0)
+            {
+                return;
+            }
+
+            Current.store(MapChunk(static_cast<size_t>(FileStat.st_size), 0));
+        }
+
+        ~TMappedFileSink()
+        {
+            ChunkType* Chunk = Current.load();
+
+            if (Chunk != nullptr)
+            {
+                // no writer is active any more, all reserved ranges of the current chunk are committed
+                const size_t FileLength = Chunk->FileOffset + Chunk->Committed.load();
+
+                ReleaseChunk(Chunk);
+
+                if (ftruncate(FileDescriptor, static_cast<off_t>(FileLength)) != 0)
+                {
+                    assert(false && "failed truncate mapped file");
+                }
+            }
+
+            if (FileDescriptor >= 0)
+            {
+                close(FileDescriptor);
+            }
+        }
+
+        /// <summary>
+        /// Determines whether the file is opened and mapped.
+        /// </summary>
+        /// <returns>bool.</returns>
+        bool IsValid() const // NOLINT(modernize-use-nodiscard)
+        {
+            return Current.load() != nullptr;
+        }
+
+        /// <summary>
+        /// Appends a string, this can be called from any thread.
+        /// </summary>
+        /// <param name="str">The string.</param>
+        /// <param name="length">The length.</param>
+        /// <returns>false if the file can't be extended.</returns>
+        bool Write(const CharType* str, const size_t length)
+        {
+            const size_t Bytes = length * sizeof(CharType);
+
+            if (Bytes == 0)
+            {
+                return IsValid();
+            }
+
+            for (;;)
+            {
+                ChunkType* Chunk = Current.load();
+
+                if (Chunk == nullptr)
+                {
+                    return false;
+                }
+
+                const size_t Start = Chunk->WriteOffset.fetch_add(Bytes);
+
+                if (Start + Bytes <= Chunk->Length)
+                {
+                    memcpy(Chunk->Data + Start, str, Bytes);
+
+                    Commit(Chunk, Bytes);
+
+                    return true;
+                }
+
+                if (Start <= Chunk->Length)
+                {
+                    // this is the only reservation which crosses the end of the chunk,
+                    // the chunk is sealed at its start, reservations after it all fail.
+                    Chunk->SealedOffset.store(Start);
+
+                    Commit(Chunk, 0);
+                }
+                else
+                {
+                    // wait until the crossing writer has sealed the chunk
+                    while (Chunk->SealedOffset.load() == NotSealed)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+
+                if (!RollOver(Chunk, Bytes))
+                {
+                    return false;
+                }
+            }
+        }
+
+    private:
+        struct ChunkType : Noncopyable
+        {
+            char*                   Data;
+            size_t                  FileOffset;
+            size_t                  Length;
+            std::atomic<size_t>     WriteOffset;
+            std::atomic<size_t>     Committed;
+            std::atomic<size_t>     SealedOffset;
+            std::atomic<bool>       Released;
+        };
+
+        enum : size_t
+        {
+            NotSealed = ~static_cast<size_t>(0)
+        };
+
+        size_t AlignToPage(const size_t size) const
+        {
+            return (size + PageSize - 1) / PageSize * PageSize;
+        }
+
+        /// <summary>
+        /// Maps a chunk starts at the file offset, the mapping itself starts at the page contains it.
+        /// </summary>
+        ChunkType* MapChunk(const size_t fileOffset, const size_t requiredBytes)
+        {
+            const size_t MapOffset = fileOffset / PageSize * PageSize;
+            const size_t StartOffset = fileOffset - MapOffset;
+            const size_t MapLength = StartOffset + requiredBytes > ChunkSize ? AlignToPage(StartOffset + requiredBytes) : ChunkSize;
+
+            if (ftruncate(FileDescriptor, static_cast<off_t>(MapOffset + MapLength)) != 0)
+            {
+                return nullptr;
+            }
+
+            void* Data = mmap(nullptr, MapLength, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor, static_cast<off_t>(MapOffset));
+
+            if (Data == MAP_FAILED) // NOLINT
+            {
+                return nullptr;
+            }
+
+            std::unique_ptr<ChunkType> Chunk(new ChunkType());
+            Chunk->Data = static_cast<char*>(Data);
+            Chunk->FileOffset = MapOffset;
+            Chunk->Length = MapLength;
+            Chunk->WriteOffset.store(StartOffset);
+            Chunk->Committed.store(StartOffset);
+            Chunk->SealedOffset.store(NotSealed);
+            Chunk->Released.store(false);
+
+            // chunks are kept until the sink is destroyed, a late writer may still read the fields of a sealed chunk
+            Chunks.push_back(std::move(Chunk));
+
+            return Chunks.back().get();
+        }
+
+        void Commit(ChunkType* chunk, const size_t bytes)
+        {
+            const size_t Committed = chunk->Committed.fetch_add(bytes) + bytes;
+
+            if (Committed == chunk->SealedOffset.load())
+            {
+                ReleaseChunk(chunk);
+            }
+        }
+
+        void ReleaseChunk(ChunkType* chunk)
+        {
+            if (!chunk->Released.exchange(true))
+            {
+                munmap(chunk->Data, chunk->Length);
+            }
+        }
+
+        bool RollOver(ChunkType* sealedChunk, const size_t requiredBytes)
+        {
+            Details::TUniqueLocker<Details::SharedMutex> Locker(ChunksMutex);
+
+            if (Current.load() != sealedChunk)
+            {
+                // another writer has mapped the next chunk
+                return true;
+            }
+
+            ChunkType* NextChunk = MapChunk(sealedChunk->FileOffset + sealedChunk->SealedOffset.load(), requiredBytes);
+
+            if (NextChunk == nullptr)
+            {
+                return false;
+            }
+
+            Current.store(NextChunk);
+
+            return true;
+        }
+
+    private:
+        int                                         FileDescriptor;
+        size_t                                      PageSize;
+        size_t                                      ChunkSize;
+        std::atomic<ChunkType*>                     Current;
+        Details::SharedMutex                        ChunksMutex;
+        std::vector< std::unique_ptr<ChunkType> >   Chunks;
+    };
+}
+#endif
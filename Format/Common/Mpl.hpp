@@ -105,48 +105,78 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
         template < typename T, int Size >
         struct IsArray< T[Size] > : TrueType {};
 
+        /// <summary>
+        /// Struct IsSigned
+        /// works for every fundamental integer type, including long and long long,
+        /// which are not always the same types as the fixed width typedefs.
+        /// </summary>
         template <typename T> // NOLINT
-        struct IsSigned : FalseType {};
+        struct IsSigned
+        {
+            enum { Value = static_cast<T>(-1) < static_cast<T>(0) };  // NOLINT(performance-enum-size)
+        };
 
-        template <>
-        struct IsSigned<int8_t> : TrueType{};
+        /// <summary>
+        /// Struct IntegerOfSize
+        /// select the fixed width integer type by byte size and signedness
+        /// </summary>
+        template <int32_t Size, bool Signed> // NOLINT
+        struct IntegerOfSize{};
 
         template <>
-        struct IsSigned<int16_t> : TrueType{};
+        struct IntegerOfSize<1, true>
+        {
+            typedef int8_t Type;
+        };
 
         template <>
-        struct IsSigned<int32_t> : TrueType{};
+        struct IntegerOfSize<1, false>
+        {
+            typedef uint8_t Type;
+        };
 
         template <>
-        struct IsSigned<int64_t> : TrueType{};
-
-        template <typename TIntegerType> // NOLINT
-        struct UnsignedTypeOf{};
+        struct IntegerOfSize<2, true>
+        {
+            typedef int16_t Type;
+        };
 
         template <>
-        struct UnsignedTypeOf<int8_t>
+        struct IntegerOfSize<2, false>
         {
-            typedef uint8_t Type;
+            typedef uint16_t Type;
         };
 
         template <>
-        struct UnsignedTypeOf<int16_t>
+        struct IntegerOfSize<4, true>
         {
-            typedef uint16_t Type;
+            typedef int32_t Type;
         };
 
         template <>
-        struct UnsignedTypeOf<int32_t>
+        struct IntegerOfSize<4, false>
         {
             typedef uint32_t Type;
         };
 
         template <>
-        struct UnsignedTypeOf<int64_t>
+        struct IntegerOfSize<8, true>
+        {
+            typedef int64_t Type;
+        };
+
+        template <>
+        struct IntegerOfSize<8, false>
         {
             typedef uint64_t Type;
         };
 
+        template <typename TIntegerType> // NOLINT
+        struct UnsignedTypeOf
+        {
+            typedef typename IntegerOfSize<sizeof(TIntegerType), false>::Type Type;
+        };
+
 #if !FL_COMPILER_IS_GREATER_THAN_CXX11
         /// <summary>
         /// Struct IsScalar
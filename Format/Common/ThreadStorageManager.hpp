@@ -0,0 +1,241 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Common/Build.hpp>
+#include <Format/Common/Noncopyable.hpp>
+#include <Format/Common/AutoArray.hpp>
+#include <Format/Common/Mutex.hpp>
+
+// the storage of an exited thread is recycled if the platform can notify the exit of a thread
+#if FL_WITH_THREAD_LOCAL
+#if FL_PLATFORM_WINDOWS && (!defined(_WIN32_WINNT) || _WIN32_WINNT < 0x0600)
+#define FL_WITH_THREAD_EXIT_CALLBACK 0
+#else
+#define FL_WITH_THREAD_EXIT_CALLBACK 1
+#endif
+#endif
+
+#if FL_WITH_THREAD_LOCAL
+// ReSharper disable once CppEnforceNestedNamespacesStyle
+namespace Formatting // NOLINT(*-concat-nested-namespaces)
+{
+    namespace Details
+    {
+        /// <summary>
+        /// Class TThreadStorageManager.
+        /// gives every thread its own TStorageType without a thread_local object, for the compilers earlier than C++11.
+        /// owns the storages of all threads, the storage of an exited thread is kept in a free list
+        /// and handed to the next new thread with its warm content, so churning threads don't grow the memory.
+        /// the storages are deleted at process exit.
+        /// Implements the <see cref="Noncopyable" />
+        /// </summary>
+        /// <seealso cref="Noncopyable" />
+        template < typename TStorageType >
+        class TThreadStorageManager : Noncopyable // NOLINT
+        {
+        public:
+            typedef TUniqueLocker<SharedMutex>                       LockerType;
+
+            /// <summary>
+            /// Gets the storage of the current thread, the first call of a thread acquires one.
+            /// </summary>
+            /// <returns>TStorageType *.</returns>
+            static TStorageType* GetStorage()
+            {
+                TStorageType*& StaticStorage = GetThreadStorage();
+
+                if( !StaticStorage )
+                {
+                    StaticStorage = GetManager().AcquireStorage();
+                }
+
+                return StaticStorage;
+            }
+
+            /// <summary>
+            /// Gets the number of storages created so far, the recycled ones are counted once.
+            /// </summary>
+            /// <returns>size_t.</returns>
+            static size_t GetStorageCount()
+            {
+                ManagedStorage& Manager = GetManager();
+
+                LockerType Locker(Manager.MutexValue);
+
+                return Manager.Storages.GetLength();
+            }
+
+        private:
+            class ManagedStorage : Noncopyable // NOLINT
+            {
+            public:
+                ManagedStorage()
+                {
+#if FL_WITH_THREAD_EXIT_CALLBACK
+#if FL_PLATFORM_WINDOWS
+                    ThreadExitKey = FlsAlloc(&ManagedStorage::OnThreadExit);
+#else
+                    bHasThreadExitKey = pthread_key_create(&ThreadExitKey, &ManagedStorage::OnThreadExit) == 0;
+#endif
+#endif
+                }
+
+                ~ManagedStorage()
+                {
+#if FL_WITH_THREAD_EXIT_CALLBACK
+                    // the manager is being destroyed, OnThreadExit must not touch it any more
+                    GetShuttingDownFlag() = true;
+
+#if FL_PLATFORM_WINDOWS
+                    if (ThreadExitKey != FLS_OUT_OF_INDEXES)
+                    {
+                        // FlsFree runs the callback on this thread for a non-null slot, clear it first
+                        FlsSetValue(ThreadExitKey, nullptr);
+                        FlsFree(ThreadExitKey);
+                    }
+#else
+                    if (bHasThreadExitKey)
+                    {
+                        pthread_key_delete(ThreadExitKey);
+                    }
+#endif
+#endif
+
+                    LockerType Locker(MutexValue);
+
+                    for( size_t i=0; i<Storages.GetLength(); ++i )
+                    {
+                        delete Storages[i];
+                    }
+                }
+
+                TStorageType* AcquireStorage()
+                {
+                    TStorageType* Storage = nullptr;
+
+                    {
+                        LockerType Locker(MutexValue);
+
+                        if (FreeStorages.GetLength() > 0)
+                        {
+                            Storage = FreeStorages[FreeStorages.GetLength() - 1];
+                            FreeStorages.RemoveLast();
+                        }
+                        else
+                        {
+                            Storage = new TStorageType();
+                            Storages.AddItem(Storage);
+                        }
+                    }
+
+#if FL_WITH_THREAD_EXIT_CALLBACK
+#if FL_PLATFORM_WINDOWS
+                    if (ThreadExitKey != FLS_OUT_OF_INDEXES)
+                    {
+                        FlsSetValue(ThreadExitKey, Storage);
+                    }
+#else
+                    if (bHasThreadExitKey)
+                    {
+                        pthread_setspecific(ThreadExitKey, Storage);
+                    }
+#endif
+#endif
+
+                    return Storage;
+                }
+
+                void ReleaseStorage(TStorageType* storage)
+                {
+                    assert(storage);
+
+                    LockerType Locker(MutexValue);
+
+                    FreeStorages.AddItem(storage);
+                }
+
+            private:
+#if FL_WITH_THREAD_EXIT_CALLBACK
+#if FL_PLATFORM_WINDOWS
+                static VOID WINAPI OnThreadExit(PVOID value)
+#else
+                static void OnThreadExit(void* value)
+#endif
+                {
+                    if (value != nullptr && !GetShuttingDownFlag())
+                    {
+                        // formatting later in the exit of this thread gets a storage again
+                        GetThreadStorage() = nullptr;
+
+                        GetManager().ReleaseStorage(static_cast<TStorageType*>(value));
+                    }
+                }
+#endif
+
+            public:
+                SharedMutex                                              MutexValue;
+                TAutoArray<TStorageType*>                                Storages;
+                TAutoArray<TStorageType*>                                FreeStorages;
+
+            private:
+#if FL_WITH_THREAD_EXIT_CALLBACK
+#if FL_PLATFORM_WINDOWS
+                DWORD                                                    ThreadExitKey;
+#else
+                pthread_key_t                                            ThreadExitKey;
+                bool                                                     bHasThreadExitKey;
+#endif
+#endif
+            };
+
+            static ManagedStorage& GetManager()
+            {
+                // used to delete Storage pointer
+                static ManagedStorage StaticManager;
+
+                return StaticManager;
+            }
+
+            static bool& GetShuttingDownFlag()
+            {
+                // trivially destructible, so it can still be read after the manager is gone
+                static bool bShuttingDown = false;
+
+                return bShuttingDown;
+            }
+
+            static TStorageType*& GetThreadStorage()
+            {
+                // ReSharper disable once CppRedundantStaticSpecifierOnThreadLocalLocalVariable
+                static FL_THREAD_LOCAL TStorageType* StaticStorage = nullptr;
+
+                return StaticStorage;
+            }
+        };
+    }
+}
+#endif
@@ -0,0 +1,183 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Common/Build.hpp>
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX20
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include <Format/Details/PatternParser.hpp>
+#include <Format/Details/FormatTo.hpp>
+
+// ReSharper disable once CppEnforceNestedNamespacesStyle
+namespace Formatting // NOLINT(*-concat-nested-namespaces)
+{
+    namespace Details
+    {
+        /// <summary>
+        /// Class TFixedString.
+        /// a string literal which can be used as a template argument.
+        /// </summary>
+        template <typename TCharType, size_t N>
+        class TFixedString
+        {
+        public:
+            typedef TCharType                                                   CharType;
+
+            constexpr TFixedString(const TCharType (&text)[N])  // NOLINT(*-explicit-constructor)
+            {
+                for (size_t i = 0; i < N; ++i)
+                {
+                    Text[i] = text[i];
+                }
+            }
+
+            constexpr static size_t GetLength()
+            {
+                return N - 1;
+            }
+
+            // ReSharper disable once CppRedundantAccessSpecifier
+        public:
+            // public, so this class is a structural type
+            TCharType                                                           Text[N];
+        };
+
+        /// <summary>
+        /// Class TFixedPatternList.
+        /// pattern list with a fixed capacity, it is filled at compile time.
+        /// </summary>
+        template <typename TCharType, size_t Capacity>
+        class TFixedPatternList
+        {
+        public:
+            TFormatPattern<TCharType>                                           Patterns[Capacity];
+            size_t                                                              Count = 0;
+        };
+
+        /// <summary>
+        /// Class TFixedPatternPolicy.
+        /// parser policy of the compile time patterns.
+        /// every pattern consumes one character at least, so Capacity patterns are enough for a format of Capacity characters.
+        /// </summary>
+        template <typename TCharType, size_t Capacity>
+        class TFixedPatternPolicy
+        {
+        public:
+            typedef TCharType                                                   CharType;
+            typedef TFormatPattern<CharType>                                    FormatPattern;
+            typedef typename FormatPattern::SizeType                            SizeType;
+            typedef typename FormatPattern::ByteType                            ByteType;
+            typedef TFixedPatternList<CharType, Capacity>                       PatternListType;
+
+            constexpr static void AppendPattern(PatternListType& patterns, const FormatPattern& pattern)
+            {
+                patterns.Patterns[patterns.Count++] = pattern;
+            }
+        };
+
+        /// <summary>
+        /// Class TCompiledLiteral.
+        /// a format literal which is parsed at compile time, create it with FL_COMPILED_FORMAT.
+        /// every literal segment becomes a copy with a constant length and every parameter becomes
+        /// a direct call of its translator with constant flags, width and precision.
+        /// </summary>
+        template <TFixedString FormatText>
+        class TCompiledLiteral
+        {
+        public:
+            typedef std::remove_cv_t<decltype(FormatText)>                      FixedStringType;
+            typedef typename FixedStringType::CharType                          CharType;
+            typedef TFixedPatternPolicy<CharType, FixedStringType::GetLength() + 1> PolicyType;
+            typedef typename PolicyType::PatternListType                        PatternListType;
+
+            constexpr static PatternListType Patterns = TPatternParser<PolicyType>::Parse(FormatText.Text, FixedStringType::GetLength());
+        };
+
+        namespace Utils
+        {
+            template <TFixedString FormatText, size_t PatternIndex, typename TCharType, typename... T>
+            inline void TransferCompiledPattern(TAutoString<TCharType>& sink, const T&... args)
+            {
+                constexpr static TFormatPattern<TCharType> Pattern = TCompiledLiteral<FormatText>::Patterns.Patterns[PatternIndex];
+
+                if constexpr (Pattern.Flag == EFormatFlag::Raw || Pattern.Index >= sizeof...(T))
+                {
+                    sink.AddStr(FormatText.Text + Pattern.Start, Pattern.Len);
+                }
+                else
+                {
+                    typedef std::tuple_element_t<Pattern.Index, std::tuple<T...>> ArgumentType;
+                    typedef std::conditional_t<
+                        std::is_array_v<ArgumentType>,
+                        const std::remove_extent_t<ArgumentType>*,
+                        ArgumentType
+                    > TransferType;
+
+                    if (!TTranslator<TCharType, TransferType>::Transfer(sink, Pattern, std::get<Pattern.Index>(std::forward_as_tuple(args...))))
+                    {
+                        sink.AddStr(FormatText.Text + Pattern.Start, Pattern.Len);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Formats to.
+        /// format params to buffer with a compile time format, there is no pattern loop at runtime.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The compiled format.</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>TAutoString&lt;TCharType&amp;.</returns>
+        template <TFixedString FormatText, typename... T>
+        inline TAutoString<typename TCompiledLiteral<FormatText>::CharType>& FormatTo(
+            TAutoString<typename TCompiledLiteral<FormatText>::CharType>& sink,
+            TCompiledLiteral<FormatText> /*format*/,
+            const T&... args
+            )
+        {
+            [&]<size_t... PatternIndices>(std::index_sequence<PatternIndices...>)
+            {
+                (Utils::TransferCompiledPattern<FormatText, PatternIndices>(sink, args...), ...);
+            }(std::make_index_sequence<TCompiledLiteral<FormatText>::Patterns.Count>());
+
+            return sink;
+        }
+    }
+}
+
+/// <summary>
+/// make a compile time format from a string literal,
+/// it can be used as the format of Format and FormatTo.
+/// example: Formatting::StandardLibrary::Format(FL_COMPILED_FORMAT("{0} - {1,8:f2}"), name, value)
+/// </summary>
+#define FL_COMPILED_FORMAT(format) (Formatting::Details::TCompiledLiteral<format>())
+
+#endif
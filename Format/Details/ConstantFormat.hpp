@@ -0,0 +1,353 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Common/Build.hpp>
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX20
+#include <array>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <string_view>
+
+#include <Format/Details/CompiledLiteralFormat.hpp>
+
+// ReSharper disable once CppEnforceNestedNamespacesStyle
+namespace Formatting // NOLINT(*-concat-nested-namespaces)
+{
+    namespace Details
+    {
+        namespace Utils
+        {
+            /// <summary>
+            /// Class TConstantWriter.
+            /// the sink of the compile time formatting, only the length is counted if the buffer is nullptr.
+            /// </summary>
+            template <typename TCharType>
+            class TConstantWriter
+            {
+            public:
+                constexpr explicit TConstantWriter(TCharType* buffer) :
+                    Buffer(buffer)
+                {
+                }
+
+                constexpr void AddChar(const TCharType ch)
+                {
+                    if (Buffer != nullptr)
+                    {
+                        Buffer[Length] = ch;
+                    }
+
+                    ++Length;
+                }
+
+                constexpr void AddStr(const TCharType* start, const size_t length)
+                {
+                    for (size_t i = 0; i < length; ++i)
+                    {
+                        AddChar(start[i]);
+                    }
+                }
+
+                constexpr void AddFill(const TCharType ch, const size_t count)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        AddChar(ch);
+                    }
+                }
+
+                // same as TAutoString::AddAlignStr
+                constexpr void AddAlignStr(const TCharType* start, const size_t length, const size_t alignedLength, const bool paddingLeft, const TCharType fillChar)
+                {
+                    const size_t PaddingLength = alignedLength > length ? alignedLength - length : 0;
+
+                    if (paddingLeft)
+                    {
+                        AddFill(fillChar, PaddingLength);
+                    }
+
+                    AddStr(start, length);
+
+                    if (!paddingLeft)
+                    {
+                        AddFill(fillChar, PaddingLength);
+                    }
+                }
+
+                constexpr size_t GetLength() const
+                {
+                    return Length;
+                }
+
+            private:
+                TCharType*              Buffer;
+                size_t                  Length = 0;
+            };
+
+            template <typename T, typename TCharType>
+            struct TIsConstantInteger
+            {
+                // character types are not numbers, but unsigned char is, same as the runtime translators
+                static constexpr bool Value = std::is_integral_v<T> &&
+                    !std::is_same_v<T, bool> &&
+                    !std::is_same_v<T, TCharType> &&
+                    !std::is_same_v<T, char> &&
+                    !std::is_same_v<T, signed char> &&
+                    !std::is_same_v<T, wchar_t> &&
+                    !std::is_same_v<T, char16_t> &&
+                    !std::is_same_v<T, char32_t>;
+            };
+
+            // there is no compile time implementation of the floating point conversions,
+            // reaching this function in constant evaluation is a compile error.
+            inline void FloatingPointIsNotSupportedInConstantFormat()
+            {
+            }
+
+            template <typename TCharType>
+            constexpr void AppendConstantString(TConstantWriter<TCharType>& writer, const TFormatPattern<TCharType>& pattern, const TCharType* start, const size_t length)
+            {
+                writer.AddAlignStr(
+                    start,
+                    length,
+                    pattern.HasWidth() ? pattern.Width : length,
+                    pattern.Align != EAlignFlag::Left,
+                    static_cast<TCharType>(' ')
+                    );
+            }
+
+            /// <summary>
+            /// Transfers an integer at compile time.
+            /// the output is the same as TIntegerTranslatorImpl.
+            /// </summary>
+            template <typename TCharType, typename TIntegerType>
+            constexpr bool TransferConstantInteger(TConstantWriter<TCharType>& writer, const TFormatPattern<TCharType>& pattern, const TIntegerType arg)
+            {
+                typedef std::make_unsigned_t<TIntegerType> UnsignedType;
+
+                TCharType Buffer[sizeof(TIntegerType) * 8 + 1] = {};
+                TCharType* const End = Buffer + FL_ARRAY_COUNTOF(Buffer);
+                TCharType* Str = End;
+
+                bool IsNegativeNumber = false;
+
+                if constexpr (std::is_signed_v<TIntegerType>)
+                {
+                    IsNegativeNumber = arg < 0;
+                }
+
+                UnsignedType Magnitude = IsNegativeNumber ?
+                    static_cast<UnsignedType>(0U - static_cast<UnsignedType>(arg)) :
+                    static_cast<UnsignedType>(arg);
+
+                switch (pattern.Flag)  // NOLINT(clang-diagnostic-switch-enum)
+                {
+                case EFormatFlag::General:
+                case EFormatFlag::Decimal:
+                case EFormatFlag::None:
+                    do
+                    {
+                        *--Str = static_cast<TCharType>('0' + Magnitude % 10);
+                        Magnitude = static_cast<UnsignedType>(Magnitude / 10);
+                    } while (Magnitude != 0);
+                    break;
+                case EFormatFlag::Hex:
+                {
+                    const char* const Digits = pattern.IsUpper ? "0123456789ABCDEF" : "0123456789abcdef";
+                    const size_t MinDigits = pattern.HasPrecision() ?
+                        Algorithm::Min(static_cast<size_t>(pattern.Precision), sizeof(TIntegerType) * 2) :
+                        1;
+
+                    do
+                    {
+                        *--Str = static_cast<TCharType>(Digits[Magnitude & 0xF]);
+                        Magnitude = static_cast<UnsignedType>(Magnitude >> 4);
+                    } while (Magnitude != 0 || static_cast<size_t>(End - Str) < MinDigits);
+                    break;
+                }
+                case EFormatFlag::Binary:
+                {
+                    // two's complement, without the sign
+                    UnsignedType Bits = static_cast<UnsignedType>(arg);
+
+                    do
+                    {
+                        *--Str = static_cast<TCharType>('0' + (Bits & 1));
+                        Bits = static_cast<UnsignedType>(Bits >> 1);
+                    } while (Bits != 0);
+
+                    IsNegativeNumber = false;
+                    break;
+                }
+                case EFormatFlag::Exponent:
+                case EFormatFlag::FixedPoint:
+                    FloatingPointIsNotSupportedInConstantFormat();
+                    return false;
+                default:
+                    return false;
+                }
+
+                const size_t Length = static_cast<size_t>(End - Str);
+
+                if (pattern.HasPrecision() && pattern.Precision > Length + IsNegativeNumber)
+                {
+                    // the sign is placed before the leading zeros
+                    if (IsNegativeNumber)
+                    {
+                        writer.AddChar(static_cast<TCharType>('-'));
+                    }
+
+                    writer.AddAlignStr(Str, Length, pattern.Precision, true, static_cast<TCharType>('0'));
+                }
+                else
+                {
+                    if (IsNegativeNumber)
+                    {
+                        *--Str = static_cast<TCharType>('-');
+                    }
+
+                    AppendConstantString(writer, pattern, Str, Length + IsNegativeNumber);
+                }
+
+                return true;
+            }
+
+            /// <summary>
+            /// Transfers an argument at compile time.
+            /// integers, bools, characters and strings are supported.
+            /// </summary>
+            template <typename TCharType, typename T>
+            constexpr bool TransferConstant(TConstantWriter<TCharType>& writer, const TFormatPattern<TCharType>& pattern, const T& arg)
+            {
+                if constexpr (std::is_same_v<T, bool>)
+                {
+                    constexpr TCharType TrueStr[] = { 'T', 'r', 'u', 'e' };
+                    constexpr TCharType FalseStr[] = { 'F', 'a', 'l', 's', 'e' };
+
+                    AppendConstantString(writer, pattern, arg ? TrueStr : FalseStr, arg ? FL_ARRAY_COUNTOF(TrueStr) : FL_ARRAY_COUNTOF(FalseStr));
+
+                    return true;
+                }
+                else if constexpr (std::is_same_v<T, TCharType>)
+                {
+                    AppendConstantString(writer, pattern, &arg, 1);
+
+                    return true;
+                }
+                else if constexpr (TIsConstantInteger<T, TCharType>::Value)
+                {
+                    return TransferConstantInteger(writer, pattern, arg);
+                }
+                else if constexpr (std::is_convertible_v<T, const TCharType*>)
+                {
+                    const TCharType* const Text = arg;
+
+                    if (Text != nullptr)
+                    {
+                        AppendConstantString(writer, pattern, Text, std::char_traits<TCharType>::length(Text));
+                    }
+
+                    return true;
+                }
+                else if constexpr (std::is_same_v<T, std::basic_string_view<TCharType>>)
+                {
+                    // same as the runtime translator, width is not used
+                    writer.AddStr(arg.data(), arg.size());
+
+                    return true;
+                }
+                else
+                {
+                    static_assert(!std::is_same_v<T, T>, "this type can't be formatted at compile time, floating point numbers are not supported.");
+
+                    return false;
+                }
+            }
+
+            template <TFixedString FormatText, size_t PatternIndex, typename TCharType, typename TArgumentsType>
+            constexpr void TransferConstantPattern(TConstantWriter<TCharType>& writer, const TArgumentsType& arguments)
+            {
+                constexpr TFormatPattern<TCharType> Pattern = TCompiledLiteral<FormatText>::Patterns.Patterns[PatternIndex];
+
+                if constexpr (Pattern.Flag == EFormatFlag::Raw || Pattern.Index >= std::tuple_size_v<TArgumentsType>)
+                {
+                    writer.AddStr(FormatText.Text + Pattern.Start, Pattern.Len);
+                }
+                else
+                {
+                    if (!TransferConstant(writer, Pattern, std::get<Pattern.Index>(arguments)))
+                    {
+                        writer.AddStr(FormatText.Text + Pattern.Start, Pattern.Len);
+                    }
+                }
+            }
+
+            template <TFixedString FormatText, typename TCharType, typename TArgumentsType>
+            constexpr size_t RenderConstant(TCharType* buffer, const TArgumentsType& arguments)
+            {
+                TConstantWriter<TCharType> Writer(buffer);
+
+                [&]<size_t... PatternIndices>(std::index_sequence<PatternIndices...>)
+                {
+                    (TransferConstantPattern<FormatText, PatternIndices>(Writer, arguments), ...);
+                }(std::make_index_sequence<TCompiledLiteral<FormatText>::Patterns.Count>());
+
+                return Writer.GetLength();
+            }
+        }
+
+        /// <summary>
+        /// Formats at compile time.
+        /// the arguments are returned by a captureless lambda, so they are constants and the length of the result can be computed first.
+        /// use FL_CONSTANT_FORMAT instead of calling it directly.
+        /// </summary>
+        /// <returns>std::array with the formatted text and a terminating zero.</returns>
+        template <TFixedString FormatText, typename TArgumentsProvider>
+        consteval auto FormatConstant(TArgumentsProvider /*provider*/)
+        {
+            typedef typename TCompiledLiteral<FormatText>::CharType CharType;
+
+            constexpr size_t Length = Utils::RenderConstant<FormatText, CharType>(nullptr, TArgumentsProvider{}());
+
+            std::array<CharType, Length + 1> Result = {};
+            Utils::RenderConstant<FormatText>(Result.data(), TArgumentsProvider{}());
+
+            return Result;
+        }
+    }
+}
+
+/// <summary>
+/// format constants at compile time, it costs nothing at runtime.
+/// only integers, bools, characters and strings can be used.
+/// example: constexpr auto Name = FL_CONSTANT_FORMAT("svc.{0}.latency", 42); // Name.data() is "svc.42.latency"
+/// </summary>
+#define FL_CONSTANT_FORMAT(format, ...) (Formatting::Details::FormatConstant<format>([] { return std::tuple(__VA_ARGS__); }))
+
+#endif
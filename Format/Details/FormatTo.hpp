@@ -27,13 +27,37 @@
 #pragma once
 
 #include <Format/Details/Translators.hpp>
+#include <Format/Details/PatternParser.hpp>
 #include <Format/Common/Mpl.hpp>
+#include <Format/Common/Mutex.hpp>
+
+// formats with at least this length are formatted in single pass mode without cache, 0 means never.
+// off by default, a long template reused on every call is faster from the cache; use FormatOnce for one-shot formats
+#ifndef FL_STREAMING_FORMAT_LENGTH
+#define FL_STREAMING_FORMAT_LENGTH 0
+#endif
 
 // ReSharper disable once CppEnforceNestedNamespacesStyle
 namespace Formatting // NOLINT(*-concat-nested-namespaces)
 {
     namespace Details
     {
+        /// <summary>
+        /// Gets the learned output length of the patterns.
+        /// pattern lists of custom policies have no hint, a policy can provide overloads for its list type,
+        /// they are found by argument dependent lookup.
+        /// </summary>
+        template <typename TPatternListType>
+        inline size_t GetLengthHint(const TPatternListType& /*patterns*/)
+        {
+            return 0;
+        }
+
+        template <typename TPatternListType>
+        inline void UpdateLengthHint(const TPatternListType& /*patterns*/, const size_t /*length*/)
+        {
+        }
+
         // calculate byte array hash code
         FL_CONSTEXPR14 inline size_t CalculateByteArrayHash(const uint8_t* const start, const size_t length)
         {
@@ -217,6 +241,171 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             return sink;
         }
 
+        /// <summary>
+        /// Formats to a sink which can only append text, such as a chunked string or a std::basic_string.
+        /// the raw patterns are appended straight from the format and the output of one placeholder at a time is staged in scratch,
+        /// so the whole result is never copied to a contiguous buffer first.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="scratch">The scratch buffer of the placeholders.</param>
+        /// <param name="patterns">patterns</param>
+        /// <param name="format">The format.</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>TSinkType &amp;.</returns>
+        template <typename TCharType, typename TSinkType, typename TPatternListType, typename... T>
+        inline TSinkType& StagedFormatTo(TSinkType& sink, TAutoString<TCharType>& scratch, const TPatternListType& patterns, const TCharType* format, const T&... args)
+        {
+            typename TPatternListType::ConstIterator Iter(patterns);
+
+            while (Iter.IsValid())
+            {
+                // ReSharper disable once CppTooWideScopeInitStatement
+                const typename TPatternListType::ConstIterator::ValueType& Pattern = *Iter;
+
+                if (Pattern.Flag == EFormatFlag::Raw)
+                {
+                    sink.AddStr(format + Pattern.Start, Pattern.Len);
+                }
+                else
+                {
+                    scratch.Clear();
+
+                    if (!Utils::DoTransfer<TCharType, typename TPatternListType::ConstIterator::ValueType, 0, T...>(scratch, Pattern, format, args...))
+                    {
+                        TRawTranslator<TCharType>::Transfer(scratch, Pattern, format);
+                    }
+
+                    sink.AddStr(scratch.CStr(), scratch.GetLength());
+                }
+
+                Iter.Next();
+            }
+
+            return sink;
+        }
+
+        namespace Utils
+        {
+            /// <summary>
+            /// Struct TErasedArgument
+            /// an argument with its translator, so the argument of a pattern can be visited by index.
+            /// </summary>
+            template <typename TCharType>
+            struct TErasedArgument
+            {
+                typedef bool (*TransferFunctionType)(TAutoString<TCharType>&, const TFormatPattern<TCharType>&, const void*);
+
+                const void*             Value;
+                TransferFunctionType    Transfer;
+            };
+
+            template <typename TCharType, typename T>
+            inline bool TransferErasedArgument(TAutoString<TCharType>& sink, const TFormatPattern<TCharType>& pattern, const void* arg)
+            {
+                typedef typename Mpl::IfElse<
+                    Mpl::IsArray<T>::Value,
+                    const typename Mpl::RemoveArray<T>::Type*,
+                    T
+                >::Type TransferType;
+
+                return TTranslator<TCharType, TransferType>::Transfer(sink, pattern, *static_cast<const T*>(arg));
+            }
+
+            template <typename TCharType, typename T>
+            inline TErasedArgument<TCharType> MakeErasedArgument(const T& arg)
+            {
+                const TErasedArgument<TCharType> Argument = { &arg, &TransferErasedArgument<TCharType, T> };
+
+                return Argument;
+            }
+
+            /// <summary>
+            /// Class TStreamingRenderer.
+            /// used as the pattern list of TStreamingPolicy, every pattern is rendered as soon as it is parsed.
+            /// </summary>
+            template <typename TCharType>
+            class TStreamingRenderer
+            {
+            public:
+                typedef TAutoString<TCharType>                                      StringType;
+                typedef TFormatPattern<TCharType>                                   FormatPattern;
+                typedef TErasedArgument<TCharType>                                  ArgumentType;
+
+                TStreamingRenderer(StringType& sink, const TCharType* format, const ArgumentType* arguments, const size_t argumentCount) :
+                    Sink(sink),
+                    Format(format),
+                    Arguments(arguments),
+                    ArgumentCount(argumentCount)
+                {
+                }
+
+                void Render(const FormatPattern& pattern)
+                {
+                    if (pattern.Flag == EFormatFlag::Raw ||
+                        pattern.Index >= ArgumentCount ||
+                        !Arguments[pattern.Index].Transfer(Sink, pattern, Arguments[pattern.Index].Value)
+                        )
+                    {
+                        TRawTranslator<TCharType>::Transfer(Sink, pattern, Format);
+                    }
+                }
+
+            private:
+                StringType&                 Sink;
+                const TCharType*            Format;
+                const ArgumentType*         Arguments;
+                size_t                      ArgumentCount;
+            };
+
+            /// <summary>
+            /// Class TStreamingPolicy.
+            /// parser policy of the single pass mode, nothing is stored.
+            /// </summary>
+            template <typename TCharType>
+            class TStreamingPolicy
+            {
+            public:
+                typedef TCharType                                                   CharType;
+                typedef TFormatPattern<CharType>                                    FormatPattern;
+                typedef typename FormatPattern::SizeType                            SizeType;
+                typedef typename FormatPattern::ByteType                            ByteType;
+                typedef TStreamingRenderer<CharType>                                PatternListType;
+
+                static void AppendPattern(PatternListType& renderer, const FormatPattern& pattern)
+                {
+                    renderer.Render(pattern);
+                }
+            };
+        }
+
+        /// <summary>
+        /// Formats to in single pass mode.
+        /// the format is parsed and rendered at the same time, the pattern storage is not used,
+        /// this is faster for formats which are used only once and does not grow the cache.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        /// <param name="length">format length</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>TAutoString&lt;TCharType&amp;.</returns>
+        template <typename TCharType, typename... T>
+        inline TAutoString<TCharType>& FormatOnceTo(TAutoString<TCharType>& sink, const TCharType* format, const size_t length, const T&... args)
+        {
+            // the last one makes sure the array is not empty
+            const Utils::TErasedArgument<TCharType> Arguments[] =
+            {
+                Utils::MakeErasedArgument<TCharType>(args)...,
+                Utils::TErasedArgument<TCharType>()
+            };
+
+            Utils::TStreamingRenderer<TCharType> Renderer(sink, format, Arguments, sizeof...(T));
+
+            TPatternParser< Utils::TStreamingPolicy<TCharType> > Parser;
+            Parser(format, length, Renderer);
+
+            return sink;
+        }
+
         /// <summary>
         /// Formats to.
         /// format params to buffer
@@ -228,14 +417,85 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
         template <typename TCharType, typename TPatternStorageType, typename TFormatType, typename... T>
         inline TAutoString<TCharType>& FormatTo(TAutoString<TCharType>& sink, const TFormatType& format, const T&... args)
         {
+            const TCharType* localFormatText = Shims::PtrOf(format);
+            const size_t localLength = Shims::LengthOf(format);
+
+            // a format without curly braces is copied verbatim, it is never hashed or cached
+            if (FindCurlyBrace(localFormatText, localFormatText + localLength) == localFormatText + localLength)
+            {
+                sink.AddStr(localFormatText, localLength);
+
+                return sink;
+            }
+
+#if FL_STREAMING_FORMAT_LENGTH > 0
+            // opt-in: long formats that are generated at runtime and used once don't pollute the cache
+            if (localLength >= FL_STREAMING_FORMAT_LENGTH)
+            {
+                return FormatOnceTo<TCharType, T...>(sink, localFormatText, localLength, args...);
+            }
+#endif
+
             TPatternStorageType* Storage = TPatternStorageType::GetStorage();
 
             assert(Storage);
 
             // find patterns first
+
+            const typename TPatternStorageType::PatternListType* Patterns = Storage->LookupPatterns(
+                localFormatText,
+                localLength,
+                CalculateByteArrayHash(reinterpret_cast<const uint8_t*>(localFormatText), localLength*sizeof(TCharType))
+                );
+
+            assert(Patterns);
+
+            // the hints are maintained only when the storage is not shared between threads
+            const bool WithLengthHint = Mpl::IsSame<SharedMutexNone, typename TPatternStorageType::MutexType>::Value;
+            const size_t StartLength = sink.GetLength();
+
+            if (WithLengthHint)
+            {
+                // grow the sink once, instead of moving from stack to heap and growing again
+                sink.Reserve(GetLengthHint(*Patterns));
+            }
+
+            FormatTo<TCharType, typename TPatternStorageType::PatternListType, T...>(sink, Patterns, localFormatText, localLength, args...);
+
+            if (WithLengthHint)
+            {
+                UpdateLengthHint(*Patterns, sink.GetLength() - StartLength);
+            }
+
+            return sink;
+        }
+
+        /// <summary>
+        /// Formats to a sink which can only append text, the sink needs AddStr, GetLength and Reserve.
+        /// the cached patterns are always used, the single pass mode would need the whole result in one buffer.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>TSinkType &amp;.</returns>
+        template <typename TCharType, typename TPatternStorageType, typename TFormatType, typename TSinkType, typename... T>
+        inline TSinkType& StagedFormatTo(TSinkType& sink, const TFormatType& format, const T&... args)
+        {
             const TCharType* localFormatText = Shims::PtrOf(format);
             const size_t localLength = Shims::LengthOf(format);
 
+            // a format without curly braces is copied verbatim, it is never hashed or cached
+            if (FindCurlyBrace(localFormatText, localFormatText + localLength) == localFormatText + localLength)
+            {
+                sink.AddStr(localFormatText, localLength);
+
+                return sink;
+            }
+
+            TPatternStorageType* Storage = TPatternStorageType::GetStorage();
+
+            assert(Storage);
+
             const typename TPatternStorageType::PatternListType* Patterns = Storage->LookupPatterns(
                 localFormatText,
                 localLength,
@@ -244,7 +504,31 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
 
             assert(Patterns);
 
-            return FormatTo<TCharType, typename TPatternStorageType::PatternListType, T...>(sink, Patterns, localFormatText, localLength, args...);
+            if (Patterns == nullptr)
+            {
+                sink.AddStr(localFormatText, localLength);
+
+                return sink;
+            }
+
+            // the hints are maintained only when the storage is not shared between threads
+            const bool WithLengthHint = Mpl::IsSame<SharedMutexNone, typename TPatternStorageType::MutexType>::Value;
+            const size_t StartLength = sink.GetLength();
+
+            if (WithLengthHint)
+            {
+                sink.Reserve(GetLengthHint(*Patterns));
+            }
+
+            TAutoString<TCharType> Scratch;
+            StagedFormatTo<TCharType, TSinkType, typename TPatternStorageType::PatternListType, T...>(sink, Scratch, *Patterns, localFormatText, args...);
+
+            if (WithLengthHint)
+            {
+                UpdateLengthHint(*Patterns, sink.GetLength() - StartLength);
+            }
+
+            return sink;
         }
 #else
 #define FL_FORMAT_TO_INDEX 0
@@ -315,6 +599,154 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
 //
 // If you want to support more parameters, you can continue to increase them here, but too large a number may cause the compiler to crash during compilation.
 //
+
+        /// <summary>
+        /// Formats every element of a contiguous range to the sink, elements are separated by separator.
+        /// the format is applied to each element as argument {0}, the patterns are resolved once
+        /// and the translator of the element type is called directly, no argument dispatch per element.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="patterns">patterns of the element format</param>
+        /// <param name="format">The element format.</param>
+        /// <param name="length">format length</param>
+        /// <param name="elements">The elements.</param>
+        /// <param name="count">elements count</param>
+        /// <param name="separator">The separator.</param>
+        /// <param name="separatorLength">separator length</param>
+        /// <returns>TAutoString&lt;TCharType&amp;.</returns>
+        template <typename TCharType, typename TPatternListType, typename T>
+        inline TAutoString<TCharType>& FormatJoinTo(
+            TAutoString<TCharType>& sink,
+            const TPatternListType* patterns,
+            const TCharType* format,
+            const size_t length,
+            const T* elements,
+            const size_t count,
+            const TCharType* separator,
+            const size_t separatorLength
+            )
+        {
+            typedef typename TPatternListType::ConstIterator                        PatternIterator;
+            typedef typename PatternIterator::ValueType                             PatternType;
+            typedef TTranslator<TCharType, T>                                       TranslatorType;
+
+            if (patterns == nullptr)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (i != 0)
+                    {
+                        sink.AddStr(separator, separatorLength);
+                    }
+
+                    sink.AddStr(format, length);
+                }
+
+                return sink;
+            }
+
+            // most element formats are a single parameter such as {0:x8}, convert them in a tight loop
+            PatternIterator First(*patterns);
+            PatternIterator Second(*patterns);
+
+            if (Second.IsValid())
+            {
+                Second.Next();
+            }
+
+            const PatternType* SinglePattern =
+                First.IsValid() && !Second.IsValid() && (*First).Flag != EFormatFlag::Raw && (*First).Index == 0 ?
+                &(*First) :
+                nullptr;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (i != 0)
+                {
+                    sink.AddStr(separator, separatorLength);
+                }
+
+                if (SinglePattern != nullptr)
+                {
+                    if (!TranslatorType::Transfer(sink, *SinglePattern, elements[i]))
+                    {
+                        TRawTranslator<TCharType>::Transfer(sink, *SinglePattern, format);
+                    }
+
+                    continue;
+                }
+
+                PatternIterator Iter(*patterns);
+
+                while (Iter.IsValid())
+                {
+                    const PatternType& Pattern = *Iter;
+
+                    if (Pattern.Flag == EFormatFlag::Raw ||
+                        Pattern.Index != 0 ||
+                        !TranslatorType::Transfer(sink, Pattern, elements[i])
+                        )
+                    {
+                        TRawTranslator<TCharType>::Transfer(sink, Pattern, format);
+                    }
+
+                    Iter.Next();
+                }
+            }
+
+            return sink;
+        }
+
+        /// <summary>
+        /// Formats every element of a contiguous range to the sink, elements are separated by separator.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The element format.</param>
+        /// <param name="elements">The elements.</param>
+        /// <param name="count">elements count</param>
+        /// <param name="separator">The separator.</param>
+        /// <param name="separatorLength">separator length</param>
+        /// <returns>TAutoString&lt;TCharType&amp;.</returns>
+        template <typename TCharType, typename TPatternStorageType, typename TFormatType, typename T>
+        inline TAutoString<TCharType>& FormatJoinTo(
+            TAutoString<TCharType>& sink,
+            const TFormatType& format,
+            const T* elements,
+            const size_t count,
+            const TCharType* separator,
+            const size_t separatorLength
+            )
+        {
+            const TCharType* localFormatText = Shims::PtrOf(format);
+            const size_t localLength = Shims::LengthOf(format);
+
+            const typename TPatternStorageType::PatternListType* Patterns = nullptr;
+
+            // a format without curly braces is repeated verbatim, it is never hashed or cached
+            if (FindCurlyBrace(localFormatText, localFormatText + localLength) != localFormatText + localLength)
+            {
+                TPatternStorageType* Storage = TPatternStorageType::GetStorage();
+
+                assert(Storage);
+
+                Patterns = Storage->LookupPatterns(
+                    localFormatText,
+                    localLength,
+                    CalculateByteArrayHash(reinterpret_cast<const uint8_t*>(localFormatText), localLength*sizeof(TCharType))
+                    );
+            }
+
+            return FormatJoinTo<TCharType, typename TPatternStorageType::PatternListType, T>(
+                sink,
+                Patterns,
+                localFormatText,
+                localLength,
+                elements,
+                count,
+                separator,
+                separatorLength
+                );
+        }
     }
 }
 
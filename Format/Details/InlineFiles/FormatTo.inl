@@ -58,6 +58,21 @@
         } \
         break;
 
+#define FL_STAGED_TRANSFER_BODY( d, i ) \
+    case i: \
+        { \
+        typedef FL_PP_CAT(T, i) Type; \
+        typedef typename Mpl::IfElse< \
+        Mpl::IsArray<Type>::Value, \
+        const typename Mpl::RemoveArray<Type>::Type*, \
+        Type >::Type TransferType; \
+        if (!TTranslator< TCharType, TransferType >::Transfer(Scratch, Pattern, FL_PP_CAT(arg, i))) \
+            { \
+            TRawTranslator< TCharType >::Transfer(Scratch, Pattern, localFormatText); \
+            } \
+        } \
+        break;
+
 //#pragma message( FL_PP_TEXT(FL_PP_REPEAT(FL_FORMAT_TO_INDEX, FL_TEMPLATE_PARAMETERS_BODY, )))
 
 /*
@@ -144,12 +159,19 @@ inline TAutoString<TCharType>& FormatTo(
     typedef typename TPatternStorageType::PatternListType  PatternListType;
     typedef typename TPatternStorageType::PatternIterator  IteratorType;
 
+    const TCharType* localFormatText = Shims::PtrOf(format);
+    const size_t localLength = Shims::LengthOf(format);
+
+    // a format without curly braces is copied verbatim, it is never hashed or cached
+    if (FindCurlyBrace(localFormatText, localFormatText + localLength) == localFormatText + localLength)
+    {
+        sink.AddStr(localFormatText, localLength);
+        return sink;
+    }
+
     TPatternStorageType* Storage = TPatternStorageType::GetStorage();
 
     assert(Storage);
-
-    const TCharType* localFormatText = Shims::PtrOf(format);
-    const size_t localLength = Shims::LengthOf(format);
     
     const PatternListType* Patterns = Storage->LookupPatterns(
         localFormatText,
@@ -159,7 +181,16 @@ inline TAutoString<TCharType>& FormatTo(
 
     assert(Patterns);
 
-    return FormatTo<
+    // the hints are maintained only when the storage is not shared between threads
+    const bool WithLengthHint = Mpl::IsSame<SharedMutexNone, typename TPatternStorageType::MutexType>::Value;
+    const size_t StartLength = sink.GetLength();
+
+    if (WithLengthHint)
+    {
+        sink.Reserve(GetLengthHint(*Patterns));
+    }
+
+    FormatTo<
                 TCharType, 
                 TPatternStorageType
                 FL_PP_COMMA_IF(FL_FORMAT_TO_INDEX)
@@ -172,6 +203,111 @@ inline TAutoString<TCharType>& FormatTo(
         FL_PP_COMMA_IF(FL_FORMAT_TO_INDEX)
         FL_PP_REPEAT(FL_FORMAT_TO_INDEX, FL_REAL_ARGUMENT_ARG_BODY, )
     );
+
+    if (WithLengthHint)
+    {
+        UpdateLengthHint(*Patterns, sink.GetLength() - StartLength);
+    }
+
+    return sink;
+}
+
+/*
+* formats to a sink which can only append text, such as a chunked string or a std::basic_string
+* the raw patterns are appended straight from the format, the output of one placeholder at a time is staged in Scratch
+* the sink needs AddStr, GetLength and Reserve
+*/
+template < 
+    typename TCharType,
+    typename TPatternStorageType,
+    typename TFormatType,
+    typename TSinkType
+    FL_PP_COMMA_IF(FL_FORMAT_TO_INDEX)
+    FL_PP_REPEAT(FL_FORMAT_TO_INDEX, FL_TEMPLATE_PARAMETERS_BODY, )
+>
+inline TSinkType& StagedFormatTo( 
+    TSinkType& sink, 
+    const TFormatType& format
+    FL_PP_COMMA_IF(FL_FORMAT_TO_INDEX)
+    FL_PP_REPEAT(FL_FORMAT_TO_INDEX, FL_REAL_ARGUMENT_BODY, )
+    )
+{
+    typedef typename TPatternStorageType::FormatPattern    FormatPatternType;
+    typedef typename TPatternStorageType::PatternListType  PatternListType;
+    typedef typename TPatternStorageType::PatternIterator  IteratorType;
+
+    const TCharType* localFormatText = Shims::PtrOf(format);
+    const size_t localLength = Shims::LengthOf(format);
+
+    // a format without curly braces is copied verbatim, it is never hashed or cached
+    if (FindCurlyBrace(localFormatText, localFormatText + localLength) == localFormatText + localLength)
+    {
+        sink.AddStr(localFormatText, localLength);
+        return sink;
+    }
+
+    TPatternStorageType* Storage = TPatternStorageType::GetStorage();
+
+    assert(Storage);
+    
+    const PatternListType* Patterns = Storage->LookupPatterns(
+        localFormatText,
+        localLength,
+        CalculateByteArrayHash(reinterpret_cast<const uint8_t*>(localFormatText), localLength*sizeof(TCharType))
+        );
+
+    assert(Patterns);
+
+    if (Patterns == nullptr)
+    {
+        sink.AddStr(localFormatText, localLength);
+        return sink;
+    }
+
+    // the hints are maintained only when the storage is not shared between threads
+    const bool WithLengthHint = Mpl::IsSame<SharedMutexNone, typename TPatternStorageType::MutexType>::Value;
+    const size_t StartLength = sink.GetLength();
+
+    if (WithLengthHint)
+    {
+        sink.Reserve(GetLengthHint(*Patterns));
+    }
+
+    TAutoString<TCharType> Scratch;
+    IteratorType Iter(*Patterns);
+
+    while (Iter.IsValid())
+    {
+        const FormatPatternType& Pattern = *Iter;
+
+        if (Pattern.Flag == EFormatFlag::Raw)
+        {
+            sink.AddStr(localFormatText + Pattern.Start, Pattern.Len);
+        }
+        else
+        {
+            Scratch.Clear();
+
+            switch (Pattern.Index)
+            {
+                FL_PP_REPEAT(FL_FORMAT_TO_INDEX, FL_STAGED_TRANSFER_BODY, );
+            default:
+                TRawTranslator<TCharType>::Transfer(Scratch, Pattern, localFormatText);
+                break;
+            }
+
+            sink.AddStr(Scratch.CStr(), Scratch.GetLength());
+        }
+
+        Iter.Next();
+    }
+
+    if (WithLengthHint)
+    {
+        UpdateLengthHint(*Patterns, sink.GetLength() - StartLength);
+    }
+
+    return sink;
 }
 
 #undef FL_REAL_ARGUMENT_ARG_BODY
@@ -179,6 +315,7 @@ inline TAutoString<TCharType>& FormatTo(
 #undef FL_TEMPLATE_PARAMETERS_BODY
 #undef FL_REAL_ARGUMENT_BODY
 #undef FL_TRANSFER_BODY
+#undef FL_STAGED_TRANSFER_BODY
 #else
 #pragma message("This is an internally used file, please do not include this file directly")
 #endif
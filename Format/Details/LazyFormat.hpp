@@ -0,0 +1,406 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Details/FormatTo.hpp>
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+#include <tuple>
+#include <type_traits>
+
+namespace Formatting
+{
+    namespace Details
+    {
+        namespace Utils
+        {
+            /// <summary>
+            /// Struct TLazyArgument
+            /// scalars are copied, so temporaries such as literals and expressions can be passed,
+            /// other types are referenced and must live longer than the lazy value.
+            /// </summary>
+            template <typename T>
+            struct TLazyArgument
+            {
+                typedef typename Mpl::IfElse<
+                    std::is_scalar<T>::value,
+                    T,
+                    const T&
+                >::Type Type;
+            };
+
+            /// <summary>
+            /// Struct TErasedTupleBuilder
+            /// fills the erased arguments of the tuple elements from Index.
+            /// </summary>
+            template <typename TCharType, size_t Index, size_t Count>
+            struct TErasedTupleBuilder
+            {
+                template <typename TTupleType>
+                static void Build(TErasedArgument<TCharType>* arguments, const TTupleType& values)
+                {
+                    arguments[Index] = MakeErasedArgument<TCharType>(std::get<Index>(values));
+
+                    TErasedTupleBuilder<TCharType, Index + 1, Count>::Build(arguments, values);
+                }
+            };
+
+            template <typename TCharType, size_t Count>
+            struct TErasedTupleBuilder<TCharType, Count, Count>
+            {
+                template <typename TTupleType>
+                static void Build(TErasedArgument<TCharType>* /*arguments*/, const TTupleType& /*values*/)
+                {
+                }
+            };
+        }
+
+        /// <summary>
+        /// Class TLazyFormat.
+        /// a format with its arguments, nothing is formatted until AppendTo is called.
+        /// creating it only copies the scalar arguments and references the others,
+        /// so a message which is never consumed costs almost nothing, the pattern lookup is also deferred.
+        /// the format and the referenced arguments must live longer than this object.
+        /// </summary>
+        template <typename TCharType, typename TPatternStorageType, typename... T>
+        class TLazyFormat
+        {
+        public:
+            typedef TCharType                                               CharType;
+            typedef TPatternStorageType                                     PatternStorageType;
+            typedef Utils::TErasedArgument<CharType>                        ArgumentType;
+            typedef std::tuple<typename Utils::TLazyArgument<T>::Type...>   ArgumentTupleType;
+
+            enum : size_t
+            {
+                ArgumentCount = sizeof...(T)
+            };
+
+            TLazyFormat(const CharType* format, const size_t length, const T&... args) :
+                Format(format),
+                Length(length),
+                Arguments(args...)
+            {
+            }
+
+            /// <summary>
+            /// Formats and appends the result to sink.
+            /// </summary>
+            /// <param name="sink">The sink.</param>
+            /// <returns>TAutoString&lt;TCharType&gt; &.</returns>
+            TAutoString<CharType>& AppendTo(TAutoString<CharType>& sink) const
+            {
+                // a format without curly braces is copied verbatim, it is never hashed or cached
+                if (FindCurlyBrace(Format, Format + Length) == Format + Length)
+                {
+                    sink.AddStr(Format, Length);
+
+                    return sink;
+                }
+
+                // the last one makes sure the array is not empty
+                ArgumentType ErasedArguments[sizeof...(T) + 1] = {};
+                BuildArguments(ErasedArguments);
+
+                Utils::TStreamingRenderer<CharType> Renderer(sink, Format, ErasedArguments, sizeof...(T));
+
+#if FL_STREAMING_FORMAT_LENGTH > 0
+                // opt-in: long formats that are generated at runtime and used once don't pollute the cache
+                if (Length >= FL_STREAMING_FORMAT_LENGTH)
+                {
+                    TPatternParser< Utils::TStreamingPolicy<CharType> > Parser;
+                    Parser(Format, Length, Renderer);
+
+                    return sink;
+                }
+#endif
+
+                TPatternStorageType* Storage = TPatternStorageType::GetStorage();
+
+                assert(Storage);
+
+                const typename TPatternStorageType::PatternListType* Patterns = Storage->LookupPatterns(
+                    Format,
+                    Length,
+                    CalculateByteArrayHash(reinterpret_cast<const uint8_t*>(Format), Length*sizeof(CharType))
+                    );
+
+                assert(Patterns);
+
+                if (Patterns == nullptr)
+                {
+                    sink.AddStr(Format, Length);
+
+                    return sink;
+                }
+
+                typename TPatternStorageType::PatternListType::ConstIterator Iter(*Patterns);
+
+                while (Iter.IsValid())
+                {
+                    Renderer.Render(*Iter);
+
+                    Iter.Next();
+                }
+
+                return sink;
+            }
+
+            /// <summary>
+            /// Formats and appends the result to a sink which can only append text, the sink needs AddStr, GetLength and Reserve.
+            /// the literal text is appended straight from the format and the output of one placeholder at a time is staged,
+            /// the cached patterns are always used.
+            /// </summary>
+            /// <param name="sink">The sink.</param>
+            /// <returns>TSinkType &amp;.</returns>
+            template <typename TSinkType>
+            TSinkType& AppendTo(TSinkType& sink) const
+            {
+                // a format without curly braces is copied verbatim, it is never hashed or cached
+                if (FindCurlyBrace(Format, Format + Length) == Format + Length)
+                {
+                    sink.AddStr(Format, Length);
+
+                    return sink;
+                }
+
+                TPatternStorageType* Storage = TPatternStorageType::GetStorage();
+
+                assert(Storage);
+
+                const typename TPatternStorageType::PatternListType* Patterns = Storage->LookupPatterns(
+                    Format,
+                    Length,
+                    CalculateByteArrayHash(reinterpret_cast<const uint8_t*>(Format), Length*sizeof(CharType))
+                    );
+
+                assert(Patterns);
+
+                if (Patterns == nullptr)
+                {
+                    sink.AddStr(Format, Length);
+
+                    return sink;
+                }
+
+                // the last one makes sure the array is not empty
+                ArgumentType ErasedArguments[sizeof...(T) + 1] = {};
+                BuildArguments(ErasedArguments);
+
+                TAutoString<CharType> Scratch;
+                Utils::TStreamingRenderer<CharType> Renderer(Scratch, Format, ErasedArguments, sizeof...(T));
+
+                typename TPatternStorageType::PatternListType::ConstIterator Iter(*Patterns);
+
+                while (Iter.IsValid())
+                {
+                    // ReSharper disable once CppTooWideScopeInitStatement
+                    const typename TPatternStorageType::FormatPattern& Pattern = *Iter;
+
+                    if (Pattern.Flag == EFormatFlag::Raw)
+                    {
+                        sink.AddStr(Format + Pattern.Start, Pattern.Len);
+                    }
+                    else
+                    {
+                        Scratch.Clear();
+                        Renderer.Render(Pattern);
+
+                        sink.AddStr(Scratch.CStr(), Scratch.GetLength());
+                    }
+
+                    Iter.Next();
+                }
+
+                return sink;
+            }
+
+            const CharType* GetFormat() const // NOLINT(modernize-use-nodiscard)
+            {
+                return Format;
+            }
+
+            size_t GetLength() const // NOLINT(modernize-use-nodiscard)
+            {
+                return Length;
+            }
+
+            /// <summary>
+            /// Fills ArgumentCount erased arguments.
+            /// they point into this object, so they are made before each use instead of in the constructor,
+            /// the object may have been moved since then.
+            /// </summary>
+            /// <param name="arguments">The arguments.</param>
+            void BuildArguments(ArgumentType* arguments) const
+            {
+                Utils::TErasedTupleBuilder<CharType, 0, sizeof...(T)>::Build(arguments, Arguments);
+            }
+
+        private:
+            const CharType*     Format;
+            size_t              Length;
+            ArgumentTupleType   Arguments;
+        };
+
+        /// <summary>
+        /// Class TFormatReader.
+        /// pulls the formatted text of a lazy value in chunks of any size, it can stop in the middle of a pattern.
+        /// literal text is copied straight from the format, only the output of the current placeholder is staged,
+        /// so the memory does not grow with the output.
+        /// the reader keeps a copy of the lazy value, the referenced arguments must live longer than the reader.
+        /// the cached patterns are always used, and the reader must be used on the thread which created it.
+        /// </summary>
+        template <typename TLazyFormatType>
+        class TFormatReader
+        {
+        public:
+            typedef typename TLazyFormatType::CharType                              CharType;
+            typedef typename TLazyFormatType::PatternStorageType                    PatternStorageType;
+            typedef typename PatternStorageType::PatternListType                    PatternListType;
+            typedef typename TLazyFormatType::ArgumentType                          ArgumentType;
+
+            explicit TFormatReader(const TLazyFormatType& value) :
+                Value(value),
+                Patterns(nullptr),
+                PatternCount(1),
+                PatternIndex(0),
+                Offset(0),
+                bStaged(false)
+            {
+                const CharType* Format = Value.GetFormat();
+                const size_t Length = Value.GetLength();
+
+                // a format without curly braces is read as one literal
+                if (FindCurlyBrace(Format, Format + Length) != Format + Length)
+                {
+                    PatternStorageType* Storage = PatternStorageType::GetStorage();
+
+                    assert(Storage);
+
+                    Patterns = Storage->LookupPatterns(
+                        Format,
+                        Length,
+                        CalculateByteArrayHash(reinterpret_cast<const uint8_t*>(Format), Length*sizeof(CharType))
+                        );
+
+                    assert(Patterns);
+
+                    if (Patterns != nullptr)
+                    {
+                        PatternCount = Patterns->GetLength();
+                    }
+                }
+            }
+
+            /// <summary>
+            /// Determines whether all text has been read.
+            /// </summary>
+            /// <returns>bool.</returns>
+            bool IsEnd() const // NOLINT(modernize-use-nodiscard)
+            {
+                return PatternIndex >= PatternCount;
+            }
+
+            /// <summary>
+            /// Reads the next chunk of text, no terminator is written.
+            /// </summary>
+            /// <param name="buffer">The buffer.</param>
+            /// <param name="capacity">The capacity of buffer in characters.</param>
+            /// <returns>the count of characters written, 0 if all text has been read.</returns>
+            size_t Read(CharType* buffer, const size_t capacity)
+            {
+                size_t Written = 0;
+
+                while (Written < capacity && !IsEnd())
+                {
+                    const CharType* Source = Value.GetFormat();
+                    size_t SourceLength = Value.GetLength();
+
+                    if (Patterns != nullptr)
+                    {
+                        const typename PatternStorageType::FormatPattern& Pattern = (*Patterns)[PatternIndex];
+
+                        if (Pattern.Flag == EFormatFlag::Raw)
+                        {
+                            Source += Pattern.Start;
+                            SourceLength = Pattern.Len;
+                        }
+                        else
+                        {
+                            if (!bStaged)
+                            {
+                                Stage(Pattern);
+                            }
+
+                            Source = Staging.CStr();
+                            SourceLength = Staging.GetLength();
+                        }
+                    }
+
+                    const size_t CopyLength = Algorithm::Min(SourceLength - Offset, capacity - Written);
+
+                    TCharTraits<CharType>::Copy(buffer + Written, Source + Offset, CopyLength);
+
+                    Written += CopyLength;
+                    Offset += CopyLength;
+
+                    if (Offset == SourceLength)
+                    {
+                        ++PatternIndex;
+                        Offset = 0;
+                        bStaged = false;
+                    }
+                }
+
+                return Written;
+            }
+
+        private:
+            void Stage(const typename PatternStorageType::FormatPattern& pattern)
+            {
+                ArgumentType Arguments[TLazyFormatType::ArgumentCount + 1] = {};
+                Value.BuildArguments(Arguments);
+
+                Staging.Clear();
+
+                Utils::TStreamingRenderer<CharType> Renderer(Staging, Value.GetFormat(), Arguments, TLazyFormatType::ArgumentCount);
+                Renderer.Render(pattern);
+
+                bStaged = true;
+            }
+
+        private:
+            TLazyFormatType             Value;
+            const PatternListType*      Patterns;
+            size_t                      PatternCount;
+            size_t                      PatternIndex;
+            size_t                      Offset;
+            TAutoString<CharType>       Staging;
+            bool                        bStaged;
+        };
+    }
+}
+#endif
@@ -97,7 +97,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <summary>
             /// Initializes a new instance of the <see cref="TFormatPattern"/> class.
             /// </summary>
-            TFormatPattern() :
+            FL_CONSTEXPR11 TFormatPattern() :
 				Start(static_cast<SizeType>(-1)),
 				Len(0),
 				Flag(EFormatFlag::Raw),
@@ -113,7 +113,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// Gets the length.
             /// </summary>
             /// <returns>SizeType.</returns>
-            FL_NO_DISCARD SizeType  GetLength() const
+            FL_NO_DISCARD FL_CONSTEXPR11 SizeType GetLength() const
             {
                 return Len;
             }
@@ -131,7 +131,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// Determines whether this instance has width.
             /// </summary>
             /// <returns>bool.</returns>
-            FL_NO_DISCARD bool    HasWidth() const
+            FL_NO_DISCARD FL_CONSTEXPR11 bool HasWidth() const
             {
                 return Width != static_cast<ByteType>(-1);
             }
@@ -140,7 +140,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// Determines whether this instance has precision.
             /// </summary>
             /// <returns>bool.</returns>
-            FL_NO_DISCARD bool    HasPrecision() const
+            FL_NO_DISCARD FL_CONSTEXPR11 bool HasPrecision() const
             {
                 return Precision != static_cast<ByteType>(-1);
             }
@@ -27,13 +27,68 @@
 
 #include <cassert>
 
+#include <Format/Common/Build.hpp>
+#if FL_COMPILER_IS_GREATER_THAN_CXX20
+#include <type_traits>
+#endif
+
 #include <Format/Details/Pattern.hpp>
+#include <Format/Common/Algorithm.hpp>
+#include <Format/Common/CharTraits.hpp>
 
 // ReSharper disable once CppEnforceNestedNamespacesStyle
 namespace Formatting // NOLINT(*-concat-nested-namespaces)
 {
     namespace Details
     {
+        /// <summary>
+        /// Finds the first curly brace.
+        /// 16 bytes are tested per step when SSE2 is available, so literal runs are skipped quickly.
+        /// </summary>
+        /// <param name="start">The start.</param>
+        /// <param name="end">The end.</param>
+        /// <returns>the position of the first '{' or '}', or end if there is not any.</returns>
+        template <typename TCharType>
+        FL_CONSTEXPR20 inline const TCharType* FindCurlyBrace(const TCharType* start, const TCharType* const end)
+        {
+#if FL_WITH_SSE2
+#if FL_COMPILER_IS_GREATER_THAN_CXX20
+            // compile time parsing of FL_COMPILED_FORMAT uses the scalar loop
+            if (!std::is_constant_evaluated())
+#endif
+            {
+                typedef TSimdCharLanes<sizeof(TCharType)> LanesType;
+
+                const ptrdiff_t LaneCount = sizeof(__m128i) / sizeof(TCharType);
+                const __m128i OpenCurly = LanesType::Splat(static_cast<TCharType>('{'));
+                const __m128i CloseCurly = LanesType::Splat(static_cast<TCharType>('}'));
+
+                for (; end - start >= LaneCount; start += LaneCount)
+                {
+                    const __m128i Text = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start));
+                    const int Mask = _mm_movemask_epi8(
+                        _mm_or_si128(LanesType::Equal(Text, OpenCurly), LanesType::Equal(Text, CloseCurly))
+                        );
+
+                    if (Mask != 0)
+                    {
+                        return start + Algorithm::CountTrailingZeros(static_cast<uint32_t>(Mask)) / sizeof(TCharType);
+                    }
+                }
+            }
+#endif
+
+            for (; start < end; ++start)
+            {
+                if (*start == '{' || *start == '}')
+                {
+                    return start;
+                }
+            }
+
+            return end;
+        }
+
         template < typename TPolicy >
         class TPatternParser
         {
@@ -45,12 +100,12 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             typedef TFormatPattern<CharType>                        FormatPattern;
 
             // ReSharper disable once CppDFAConstantFunctionResult
-            bool operator ()(const CharType* const formatStart, const SizeType length, PatternListType& patterns)
+            FL_CONSTEXPR20 bool operator ()(const CharType* const formatStart, const SizeType length, PatternListType& patterns)
             {
                 return ParsePatterns(formatStart, length, patterns);
             }
 
-            static PatternListType Parse(const CharType* const formatStart, const SizeType length)
+            FL_CONSTEXPR20 static PatternListType Parse(const CharType* const formatStart, const SizeType length)
             {
                 PatternListType Patterns;
                 TPatternParser Parser;
@@ -83,13 +138,30 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             typedef typename EParseState::Enum  ParseStateType;
 #endif
 
+            // the pattern syntax is pure ASCII, so these tests do not depend on the current locale
+            // and can be used when the parser runs at compile time.
+            FL_CONSTEXPR11 static bool IsDigitChar(const CharType ch)
+            {
+                return ch >= '0' && ch <= '9';
+            }
+
+            FL_CONSTEXPR11 static bool IsUpperChar(const CharType ch)
+            {
+                return ch >= 'A' && ch <= 'Z';
+            }
+
+            FL_CONSTEXPR11 static CharType ToUpperChar(const CharType ch)
+            {
+                return ch >= 'a' && ch <= 'z' ? static_cast<CharType>(ch - 'a' + 'A') : ch;
+            }
+
             /// <summary>
             /// Casts to small number.
             /// </summary>
             /// <param name="start">The start.</param>
             /// <param name="end">The end.</param>
             /// <returns>int32_t.</returns>
-            static int32_t CastToSmallNumber(const CharType* const start, const CharType* const end)
+            FL_CONSTEXPR20 static int32_t CastToSmallNumber(const CharType* const start, const CharType* const end)
             {
                 assert(start && end && start < end && "invalid parameters!");
                 assert(end - start < 3 && "too large integer!!!");
@@ -125,7 +197,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <param name="end">The end.</param>
             /// <param name="endPoint">The end point.</param>
             /// <returns>int32_t.</returns>
-            static int32_t FindNextNumber(
+            FL_CONSTEXPR20 static int32_t FindNextNumber(
                 const CharType* const start,
                 const CharType* const end,
                 const CharType*& endPoint
@@ -133,7 +205,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             {
                 const CharType* TestPtr = start;
 
-                while (TestPtr < end && TCharTraits<CharType>::IsDigit(*TestPtr))
+                while (TestPtr < end && IsDigitChar(*TestPtr))
                 {
                     ++TestPtr;
                 }
@@ -157,7 +229,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <param name="end">The end.</param>
             /// <param name="pattern">The pattern.</param>
             /// <returns>bool.</returns>
-            static bool ParseAlignMode(const CharType* const start, const CharType* const end, FormatPattern& pattern)
+            FL_CONSTEXPR20 static bool ParseAlignMode(const CharType* const start, const CharType* const end, FormatPattern& pattern)
             {
                 assert(start && end && start < end && "invalid parameters!");
 
@@ -166,7 +238,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                 // ReSharper disable once CppDFANullDereference
                 ++TestPtr;
 
-                if (TestPtr >= end || (!TCharTraits<CharType>::IsDigit(*TestPtr) && *TestPtr != '-'))
+                if (TestPtr >= end || (!IsDigitChar(*TestPtr) && *TestPtr != '-'))
                 {
                     return false;
                 }
@@ -211,7 +283,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <param name="end">The end.</param>
             /// <param name="pattern">The pattern.</param>
             /// <returns>bool.</returns>
-            static bool ParseFormatMode(const CharType* const start, const CharType* const end, FormatPattern& pattern)
+            FL_CONSTEXPR20 static bool ParseFormatMode(const CharType* const start, const CharType* const end, FormatPattern& pattern)
             {
                 assert(start && end && start < end && "invalid parameters!");
 
@@ -225,7 +297,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                     return false;
                 }
 
-                switch (TCharTraits<CharType>::ToUpper(*TestPtr))
+                switch (ToUpperChar(*TestPtr))
                 {
                 case 'D':
                     pattern.Flag = EFormatFlag::Decimal;
@@ -257,7 +329,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                     return false;
                 }
 
-                pattern.IsUpper = TCharTraits<CharType>::IsUpper(*TestPtr);
+                pattern.IsUpper = IsUpperChar(*TestPtr);
 
                 ++TestPtr;
 
@@ -266,7 +338,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                     return true;
                 }
 
-                if (TCharTraits<CharType>::IsDigit(*TestPtr))
+                if (IsDigitChar(*TestPtr))
                 {
                     // get Precision
                     const int32_t val = FindNextNumber(TestPtr, end, TestPtr);
@@ -287,7 +359,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <param name="end">The end.</param>
             /// <param name="pattern">The pattern.</param>
             /// <returns>bool.</returns>
-            static bool ParseParameter(const CharType* const start, const CharType* const end, FormatPattern& pattern)
+            FL_CONSTEXPR20 static bool ParseParameter(const CharType* const start, const CharType* const end, FormatPattern& pattern)
             {
                 // 1. find the parameter index
                 assert(start && end && "invalid parameters!!!");
@@ -295,7 +367,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                 const CharType* TestPtr = start;
 
                 // ReSharper disable once CppDFANullDereference
-                while (TestPtr < end && !TCharTraits<CharType>::IsDigit(*TestPtr))
+                while (TestPtr < end && !IsDigitChar(*TestPtr))
                 {
                     ++TestPtr;
                 }
@@ -303,7 +375,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                 const CharType* TestPtr2 = TestPtr;
 
                 // ReSharper disable once CppDFANullDereference
-                while (TestPtr2 < end && TCharTraits<CharType>::IsDigit(*TestPtr2))
+                while (TestPtr2 < end && IsDigitChar(*TestPtr2))
                 {
                     ++TestPtr2;
                 }
@@ -356,7 +428,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <summary>
             /// Called when get a [literal].
             /// </summary>            
-            void OnLiteral(
+            FL_CONSTEXPR20 void OnLiteral(
                 const CharType*& /*p0*/,
                 const CharType*& p1,
                 const CharType* const /*start*/,
@@ -388,7 +460,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <param name="start">The start.</param>
             /// <param name="state">The state.</param>
             /// <param name="patterns">The patterns.</param>
-            void OnOpenCurly(
+            FL_CONSTEXPR20 void OnOpenCurly(
                 const CharType*& p0,
                 const CharType*& p1,
                 const CharType* const start,
@@ -448,7 +520,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <summary>
             /// Called when get a [close curly].
             /// </summary>
-            void OnCloseCurly(
+            FL_CONSTEXPR20 void OnCloseCurly(
                 const CharType*& p0,
                 const CharType*& p1,
                 const CharType* const start,
@@ -514,7 +586,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <param name="start">The start.</param>
             /// <param name="state">The state.</param>
             /// <param name="patterns">The patterns.</param>
-            void OnParameter(
+            FL_CONSTEXPR20 void OnParameter(
                 const CharType*& p0,
                 const CharType*& p1,
                 const CharType* const start,
@@ -560,7 +632,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                         format_pattern.Start = p0 - start;
                         format_pattern.Len = p1 - p0 + 1;
 
-                        TPolicy::AppendPattern(patterns, pattern);
+                        TPolicy::AppendPattern(patterns, format_pattern);
                     }
 
                     p0 = p1 + 1;
@@ -578,7 +650,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             /// <param name="length">The length.</param>
             /// <param name="patterns">The patterns.</param>
             /// <returns>bool.</returns>
-            bool ParsePatterns(
+            FL_CONSTEXPR20 bool ParsePatterns(
                 const CharType* const formatStart,
                 const SizeType length,
                 PatternListType& patterns
@@ -592,6 +664,17 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
 
                 for (; p1 < end; ++p1)
                 {
+                    // jump over the literal run, only curly braces can change the state
+                    if (state == EParseState::Literal)
+                    {
+                        p1 = FindCurlyBrace(p1, end);
+
+                        if (p1 == end)
+                        {
+                            break;
+                        }
+                    }
+
                     switch (state) // NOLINT(clang-diagnostic-switch-enum)
                     {
                     case EParseState::Literal:
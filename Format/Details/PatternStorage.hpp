@@ -27,6 +27,7 @@
 
 #include <Format/Details/PatternParser.hpp>
 #include <Format/Common/Mutex.hpp>
+#include <Format/Common/ThreadStorageManager.hpp>
 
 // ReSharper disable once CppEnforceNestedNamespacesStyle
 namespace Formatting // NOLINT(*-concat-nested-namespaces)
@@ -214,47 +215,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                 thread_local TGlobalPatternStorage StaticStorage;
                 return &StaticStorage;
 #else
-                struct ManagedStorage : Noncopyable // NOLINT
-                {
-                    typedef TUniqueLocker<SharedMutex>                       LockerType;
-
-                    SharedMutex                                              MutexValue;
-                    TAutoArray<TGlobalPatternStorage*>                       Storages;
-
-                    ~ManagedStorage()
-                    {
-                        LockerType Locker(MutexValue);
-
-                        for( size_t i=0; i<Storages.GetLength(); ++i )
-                        {
-                            delete Storages[i];
-                        }
-                    }
-
-                    void AddStorage( TGlobalPatternStorage* inputStorage )
-                    {
-                        assert(inputStorage);
-
-                        LockerType Locker(MutexValue);
-
-                        Storages.AddItem(inputStorage);
-                    }
-                };
-
-                // used to delete Storage pointer
-                static ManagedStorage StaticManager;
-
-                // ReSharper disable once CppRedundantStaticSpecifierOnThreadLocalLocalVariable
-                static FL_THREAD_LOCAL TGlobalPatternStorage* StaticStorage = nullptr;
-
-                if( !StaticStorage )
-                {
-                    StaticStorage = new TGlobalPatternStorage();
-
-                    StaticManager.AddStorage(StaticStorage);
-                }
-
-                return StaticStorage;
+                return TThreadStorageManager<TGlobalPatternStorage>::GetStorage();
 #endif
 #else
                 #if !FL_WITH_MULTITHREAD_SUPPORT
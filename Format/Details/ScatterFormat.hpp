@@ -0,0 +1,368 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Details/FormatTo.hpp>
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+
+#if !FL_PLATFORM_WINDOWS
+#include <cerrno>
+#include <sys/uio.h>
+#endif
+
+namespace Formatting
+{
+    // literals shorter than this are copied into the scratch buffer, a tiny segment costs more than the copy
+#ifndef FL_SCATTER_MIN_LITERAL_LENGTH
+#define FL_SCATTER_MIN_LITERAL_LENGTH 16
+#endif
+
+    /// <summary>
+    /// Class TScatterOutput.
+    /// formatted text as a list of segments, literal segments point into the format string and
+    /// only the output of the placeholders is written to a scratch buffer.
+    /// the format string must live longer than this object.
+    /// Implements the <see cref="Noncopyable" />
+    /// </summary>
+    /// <seealso cref="Noncopyable" />
+    template < typename TCharType >
+    class TScatterOutput : Noncopyable
+    {
+    public:
+        typedef TCharType           CharType;
+
+        /// <summary>
+        /// Struct Segment.
+        /// Literal is nullptr if the segment is stored in the scratch buffer, Start is the offset in it.
+        /// </summary>
+        struct Segment
+        {
+            const CharType*     Literal;
+            size_t              Start;
+            size_t              Length;
+        };
+
+        typedef TAutoArray<Segment, 0x20, 0>    SegmentListType;
+
+        TScatterOutput() :
+            TotalLength(0)
+        {
+        }
+
+        /// <summary>
+        /// Adds a segment which references the text directly.
+        /// </summary>
+        /// <param name="str">The string.</param>
+        /// <param name="length">The length.</param>
+        void AddLiteral(const CharType* str, const size_t length)
+        {
+            if (length < FL_SCATTER_MIN_LITERAL_LENGTH)
+            {
+                const size_t Start = Scratch.GetLength();
+
+                Scratch.AddStr(str, length);
+
+                AddScratch(Start);
+            }
+            else if (length > 0)
+            {
+                Segment Value = { str, 0, length };
+
+                Segments.AddItem(Value);
+
+                TotalLength += length;
+            }
+        }
+
+        /// <summary>
+        /// Gets the scratch buffer, the content appended to it must be registered with AddScratch.
+        /// </summary>
+        /// <returns>TAutoString&lt;CharType&gt; &.</returns>
+        TAutoString<CharType>& GetScratch()
+        {
+            return Scratch;
+        }
+
+        /// <summary>
+        /// Adds the content of the scratch buffer after start as a segment,
+        /// it is merged into the last segment if they are adjacent.
+        /// </summary>
+        /// <param name="start">The start offset in the scratch buffer.</param>
+        void AddScratch(const size_t start)
+        {
+            const size_t Length = Scratch.GetLength() - start;
+
+            if (Length == 0)
+            {
+                return;
+            }
+
+            TotalLength += Length;
+
+            if (Segments.GetLength() > 0)
+            {
+                Segment& Last = Segments[Segments.GetLength() - 1];
+
+                if (Last.Literal == nullptr && Last.Start + Last.Length == start)
+                {
+                    Last.Length += Length;
+
+                    return;
+                }
+            }
+
+            Segment Value = { nullptr, start, Length };
+
+            Segments.AddItem(Value);
+        }
+
+        /// <summary>
+        /// Gets the segment count.
+        /// </summary>
+        /// <returns>size_t.</returns>
+        size_t GetSegmentCount() const // NOLINT(modernize-use-nodiscard)
+        {
+            return Segments.GetLength();
+        }
+
+        /// <summary>
+        /// Gets the text of a segment, scratch segments are resolved here because the scratch buffer may move while it grows.
+        /// </summary>
+        /// <param name="index">The index.</param>
+        /// <returns>const CharType*.</returns>
+        const CharType* GetSegmentData(const size_t index) const // NOLINT(modernize-use-nodiscard)
+        {
+            const Segment& Value = Segments[index];
+
+            return Value.Literal != nullptr ? Value.Literal : Scratch.CStr() + Value.Start;
+        }
+
+        /// <summary>
+        /// Gets the length of a segment.
+        /// </summary>
+        /// <param name="index">The index.</param>
+        /// <returns>size_t.</returns>
+        size_t GetSegmentLength(const size_t index) const // NOLINT(modernize-use-nodiscard)
+        {
+            return Segments[index].Length;
+        }
+
+        /// <summary>
+        /// Gets the total length of all segments.
+        /// </summary>
+        /// <returns>size_t.</returns>
+        size_t GetLength() const // NOLINT(modernize-use-nodiscard)
+        {
+            return TotalLength;
+        }
+
+        /// <summary>
+        /// Copies all segments to a string.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        void CopyTo(TAutoString<CharType>& sink) const
+        {
+            for (size_t i = 0; i < Segments.GetLength(); ++i)
+            {
+                sink.AddStr(GetSegmentData(i), GetSegmentLength(i));
+            }
+        }
+
+        void Clear()
+        {
+            Segments.Clear();
+            Scratch.Clear();
+            TotalLength = 0;
+        }
+
+#if !FL_PLATFORM_WINDOWS
+        /// <summary>
+        /// Fills io vectors with the segments from the first segment.
+        /// </summary>
+        /// <param name="vectors">The vectors.</param>
+        /// <param name="capacity">The capacity of vectors.</param>
+        /// <param name="first">The first segment.</param>
+        /// <returns>the count of filled vectors.</returns>
+        size_t ToIoVectors(struct iovec* vectors, const size_t capacity, const size_t first = 0) const
+        {
+            size_t Count = 0;
+
+            for (size_t i = first; i < Segments.GetLength() && Count < capacity; ++i, ++Count)
+            {
+                vectors[Count].iov_base = const_cast<CharType*>(GetSegmentData(i)); // NOLINT
+                vectors[Count].iov_len = GetSegmentLength(i) * sizeof(CharType);
+            }
+
+            return Count;
+        }
+
+        /// <summary>
+        /// Writes all segments to a file descriptor or socket with writev.
+        /// </summary>
+        /// <param name="fileDescriptor">The file descriptor.</param>
+        /// <returns>false if writev fails.</returns>
+        bool WriteTo(const int fileDescriptor) const
+        {
+            struct iovec Vectors[64]; // NOLINT
+            size_t First = 0;
+            size_t SkipBytes = 0;
+
+            while (First < Segments.GetLength())
+            {
+                const size_t Count = ToIoVectors(Vectors, FL_ARRAY_COUNTOF(Vectors), First);
+
+                // continue from the middle of the first segment after a partial write
+                Vectors[0].iov_base = static_cast<char*>(Vectors[0].iov_base) + SkipBytes;
+                Vectors[0].iov_len -= SkipBytes;
+
+                const ssize_t Written = ::writev(fileDescriptor, Vectors, static_cast<int>(Count));
+
+                if (Written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return false;
+                }
+
+                size_t Remain = static_cast<size_t>(Written) + SkipBytes;
+                SkipBytes = 0;
+
+                while (First < Segments.GetLength() && Remain > 0)
+                {
+                    const size_t Bytes = GetSegmentLength(First) * sizeof(CharType);
+
+                    if (Remain < Bytes)
+                    {
+                        SkipBytes = Remain;
+                        break;
+                    }
+
+                    Remain -= Bytes;
+                    ++First;
+                }
+            }
+
+            return true;
+        }
+#endif
+
+    private:
+        SegmentListType             Segments;
+        TAutoString<CharType>       Scratch;
+        size_t                      TotalLength;
+    };
+
+    namespace Details
+    {
+        /// <summary>
+        /// Formats to segments, the raw patterns reference the format directly.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="patterns">The patterns.</param>
+        /// <param name="format">The format.</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>TScatterOutput&lt;TCharType&gt; &.</returns>
+        template <typename TCharType, typename TPatternListType, typename... T>
+        inline TScatterOutput<TCharType>& ScatterFormatTo(TScatterOutput<TCharType>& sink, const TPatternListType& patterns, const TCharType* format, const T&... args)
+        {
+            typename TPatternListType::ConstIterator Iter(patterns);
+
+            while (Iter.IsValid())
+            {
+                // ReSharper disable once CppTooWideScopeInitStatement
+                const typename TPatternListType::ConstIterator::ValueType& Pattern = *Iter;
+
+                if (Pattern.Flag == EFormatFlag::Raw)
+                {
+                    sink.AddLiteral(format + Pattern.Start, Pattern.Len);
+                }
+                else
+                {
+                    const size_t Start = sink.GetScratch().GetLength();
+
+                    if (!Utils::DoTransfer<TCharType, typename TPatternListType::ConstIterator::ValueType, 0, T...>(sink.GetScratch(), Pattern, format, args...))
+                    {
+                        TRawTranslator<TCharType>::Transfer(sink.GetScratch(), Pattern, format);
+                    }
+
+                    sink.AddScratch(Start);
+                }
+
+                Iter.Next();
+            }
+
+            return sink;
+        }
+
+        /// <summary>
+        /// Formats to segments with the cached patterns of the format.
+        /// the streaming path of FormatTo is not used, literal references are only useful for formats which live long.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>TScatterOutput&lt;TCharType&gt; &.</returns>
+        template <typename TCharType, typename TPatternStorageType, typename TFormatType, typename... T>
+        inline TScatterOutput<TCharType>& ScatterFormatTo(TScatterOutput<TCharType>& sink, const TFormatType& format, const T&... args)
+        {
+            const TCharType* localFormatText = Shims::PtrOf(format);
+            const size_t localLength = Shims::LengthOf(format);
+
+            if (FindCurlyBrace(localFormatText, localFormatText + localLength) == localFormatText + localLength)
+            {
+                sink.AddLiteral(localFormatText, localLength);
+
+                return sink;
+            }
+
+            TPatternStorageType* Storage = TPatternStorageType::GetStorage();
+
+            assert(Storage);
+
+            const typename TPatternStorageType::PatternListType* Patterns = Storage->LookupPatterns(
+                localFormatText,
+                localLength,
+                CalculateByteArrayHash(reinterpret_cast<const uint8_t*>(localFormatText), localLength*sizeof(TCharType))
+                );
+
+            assert(Patterns);
+
+            if (Patterns == nullptr)
+            {
+                sink.AddLiteral(localFormatText, localLength);
+
+                return sink;
+            }
+
+            return ScatterFormatTo<TCharType, typename TPatternStorageType::PatternListType, T...>(sink, *Patterns, localFormatText, args...);
+        }
+    }
+}
+#endif
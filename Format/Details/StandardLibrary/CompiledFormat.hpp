@@ -0,0 +1,184 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+// ReSharper disable CppRedundantInlineSpecifier
+#pragma once
+
+#include <string>
+#include <Format/Details/PatternParser.hpp>
+#include <Format/Details/StandardLibrary/StandardLibraryPolicy.hpp>
+#include <Format/Details/StandardLibrary/FormatTo.hpp>
+#include <Format/Details/CompiledLiteralFormat.hpp>
+
+namespace Formatting
+{
+    namespace Details // NOLINT
+    {
+        namespace StandardLibrary
+        {
+            /// <summary>
+            /// Class TCompiledFormat.
+            /// owns a copy of the format text and its parsed patterns,
+            /// formatting with it needs no hashing and no pattern storage lookup.
+            /// it is copyable, and patterns refer to the text by offsets, so copies stay valid.
+            /// </summary>
+            template <typename TCharType>
+            class TCompiledFormat
+            {
+            public:
+                typedef TCharType                                                       CharType;
+                typedef TStandardPolicy<TCharType, DefaultMutexType>                    PolicyType;
+                typedef typename PolicyType::PatternListType                            PatternListType;
+                typedef std::basic_string<TCharType>                                    StringType;
+
+                TCompiledFormat(const TCharType* format, const size_t length) :
+                    Text(format, length),
+                    Patterns(TPatternParser<PolicyType>::Parse(Text.c_str(), Text.size()))
+                {
+                }
+
+                const PatternListType* GetPatterns() const  // NOLINT(modernize-use-nodiscard)
+                {
+                    return &Patterns;
+                }
+
+                const TCharType* GetText() const  // NOLINT(modernize-use-nodiscard)
+                {
+                    return Text.c_str();
+                }
+
+                size_t GetLength() const  // NOLINT(modernize-use-nodiscard)
+                {
+                    return Text.size();
+                }
+
+            private:
+                StringType                      Text;
+                PatternListType                 Patterns;
+            };
+        }
+    }
+
+    namespace StandardLibrary
+    {
+        /// <summary>
+        /// Compiles the format for repeated use.
+        /// use it for formats which are not literals, such as formats loaded from configurations,
+        /// the returned handle can be passed to Format and FormatTo instead of the format text.
+        /// </summary>
+        /// <param name="format">The format.</param>
+        /// <returns>the compiled format handle.</returns>
+        template <typename TCharType>
+        inline Details::StandardLibrary::TCompiledFormat<TCharType> Compile(const TCharType* format)
+        {
+            return Details::StandardLibrary::TCompiledFormat<TCharType>(format, TCharTraits<TCharType>::length(format));
+        }
+
+        template <typename TCharType>
+        inline Details::StandardLibrary::TCompiledFormat<TCharType> Compile(const std::basic_string<TCharType>& format)
+        {
+            return Details::StandardLibrary::TCompiledFormat<TCharType>(format.c_str(), format.size());
+        }
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX17
+        template <typename TCharType>
+        inline Details::StandardLibrary::TCompiledFormat<TCharType> Compile(const std::basic_string_view<TCharType>& format)
+        {
+            return Details::StandardLibrary::TCompiledFormat<TCharType>(format.data(), format.size());
+        }
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+        template <typename TCharType>
+        inline std::basic_string<TCharType> Format(const Details::StandardLibrary::TCompiledFormat<TCharType>& format)
+        {
+            return Format<TCharType>(format.GetPatterns(), format.GetText(), format.GetLength());
+        }
+
+        template <typename TCharType>
+        inline std::basic_string<TCharType>& FormatTo(std::basic_string<TCharType>& sink, const Details::StandardLibrary::TCompiledFormat<TCharType>& format)
+        {
+            return FormatTo<TCharType>(sink, format.GetPatterns(), format.GetText(), format.GetLength());
+        }
+
+        template <typename TCharType, typename T0, typename... T>
+        inline std::basic_string<TCharType> Format(const Details::StandardLibrary::TCompiledFormat<TCharType>& format, const T0& arg0, T... args)
+        {
+            return Format<TCharType, T0, T...>(format.GetPatterns(), format.GetText(), format.GetLength(), arg0, args...);
+        }
+
+        template <typename TCharType, typename T0, typename... T>
+        inline std::basic_string<TCharType>& FormatTo(std::basic_string<TCharType>& sink, const Details::StandardLibrary::TCompiledFormat<TCharType>& format, const T0& arg0, T... args)
+        {
+            return FormatTo<TCharType, T0, T...>(sink, format.GetPatterns(), format.GetText(), format.GetLength(), arg0, args...);
+        }
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX20
+        /// <summary>
+        /// Formats with a compile time format, see FL_COMPILED_FORMAT.
+        /// </summary>
+        /// <param name="format">The compiled format.</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>the formatted string.</returns>
+        template <Details::TFixedString FormatText, typename... T>
+        inline std::basic_string<typename Details::TCompiledLiteral<FormatText>::CharType> Format(const Details::TCompiledLiteral<FormatText>& format, const T&... args)
+        {
+            typedef typename Details::TCompiledLiteral<FormatText>::CharType CharType;
+
+            TAutoString<CharType> Sink;
+            Details::FormatTo(Sink, format, args...);
+
+            return std::basic_string<CharType>(Sink.CStr(), Sink.GetLength());
+        }
+
+        template <typename TCharType, Details::TFixedString FormatText>
+        inline std::basic_string<TCharType>& FormatTo(std::basic_string<TCharType>& sink, const Details::TCompiledLiteral<FormatText>& format)
+        {
+            sink.clear();
+
+            TAutoString<TCharType> Sink;
+            Details::FormatTo(Sink, format);
+
+            sink.assign(Sink.CStr(), Sink.GetLength());
+
+            return sink;
+        }
+
+        template <typename TCharType, Details::TFixedString FormatText, typename T0, typename... T>
+        inline std::basic_string<TCharType>& FormatTo(std::basic_string<TCharType>& sink, const Details::TCompiledLiteral<FormatText>& format, const T0& arg0, T... args)
+        {
+            sink.clear();
+
+            TAutoString<TCharType> Sink;
+            Details::FormatTo(Sink, format, arg0, args...);
+
+            sink.assign(Sink.CStr(), Sink.GetLength());
+
+            return sink;
+        }
+#endif
+    }
+}
@@ -27,7 +27,15 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <iosfwd>
+#include <Format/Common/FileSink.hpp>
+#include <Format/Common/ChunkedString.hpp>
+#include <Format/Common/MappedFileSink.hpp>
+#include <Format/Common/AsyncFileWriter.hpp>
 #include <Format/Details/FormatTo.hpp>
+#include <Format/Details/ScatterFormat.hpp>
+#include <Format/Details/LazyFormat.hpp>
 #include <Format/Details/StandardLibrary/StandardLibraryPolicy.hpp>
 
 namespace Formatting
@@ -67,6 +75,65 @@ namespace Formatting
             }
         };
 #endif
+
+        namespace StandardLibrary
+        {
+            /// <summary>
+            /// Class TStringAppender.
+            /// appends the text of StagedFormatTo in place after the existing content of a std::basic_string.
+            /// </summary>
+            template < typename TCharType >
+            class TStringAppender
+            {
+            public:
+                typedef TCharType                       CharType;
+
+                explicit TStringAppender(std::basic_string<CharType>& str) :
+                    String(str)
+                {
+                }
+
+                void AddStr(const CharType* str, const size_t length)
+                {
+                    String.append(str, length);
+                }
+
+                size_t GetLength() const // NOLINT(modernize-use-nodiscard)
+                {
+                    return String.size();
+                }
+
+                /// <summary>
+                /// Makes sure length more characters fit without growing the string again.
+                /// the growth is kept geometric, some standard libraries reserve the exact size.
+                /// </summary>
+                /// <param name="length">The length.</param>
+                void Reserve(const size_t length)
+                {
+                    const size_t RequiredLength = String.size() + length;
+
+                    if (RequiredLength > String.capacity())
+                    {
+                        String.reserve(Algorithm::Max(RequiredLength, String.capacity() * 2));
+                    }
+                }
+
+            private:
+                std::basic_string<CharType>&            String;
+            };
+        }
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+        // the lazy formatted value is rendered only when it is written to a stream
+        template <typename TCharType, typename TPatternStorageType, typename... T>
+        inline std::basic_ostream<TCharType>& operator << (std::basic_ostream<TCharType>& stream, const TLazyFormat<TCharType, TPatternStorageType, T...>& lazy)
+        {
+            TAutoString<TCharType> Sink;
+            lazy.AppendTo(Sink);
+
+            return stream.write(Sink.CStr(), static_cast<std::streamsize>(Sink.GetLength()));
+        }
+#endif
     }
 
     namespace StandardLibrary
@@ -122,6 +189,56 @@ namespace Formatting
             sink = Format<wchar_t>(format);
         }
 
+        /// <summary>
+        /// Appends the formatted text in place after the existing content of sink, no temporary string is created.
+        /// the literal text is appended straight from the format, the output of one placeholder at a time is staged
+        /// in a TAutoString, so only a placeholder longer than FL_DEFAULT_AUTO_STRING_STACK_LENGTH characters touches the heap
+        /// besides the amortized growth of sink.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        /// <returns>sink</returns>
+        template <typename TCharType, typename TFormatType>
+        inline std::basic_string<TCharType>& AppendFormat(std::basic_string<TCharType>& sink, const TFormatType& format)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+            typedef Details::StandardLibrary::TStringAppender<TCharType>                                                                                SinkType;
+
+            SinkType Sink(sink);
+            Details::StagedFormatTo<TCharType, GlobalPatternStorageType, TFormatType, SinkType>(Sink, format);
+
+            return sink;
+        }
+
+        /// <summary>
+        /// Formats directly into the buffer of a file sink, the buffer is written to the file when it is full.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        template <typename TCharType, typename TFormatType>
+        inline void FormatTo(TFileSink<TCharType>& sink, const TFormatType& format)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            Details::FormatTo<TCharType, GlobalPatternStorageType, TFormatType>(sink.GetBuffer(), format);
+
+            sink.FlushIfFull();
+        }
+
+        /// <summary>
+        /// Appends the formatted text to a chunked string, the content written before is never moved.
+        /// the literal text is copied straight into the blocks, only the output of one placeholder at a time is staged.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        template <typename TCharType, typename TFormatType>
+        inline void FormatTo(TChunkedString<TCharType>& sink, const TFormatType& format)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            Details::StagedFormatTo<TCharType, GlobalPatternStorageType, TFormatType, TChunkedString<TCharType> >(sink, format);
+        }
+
 #if FL_COMPILER_IS_GREATER_THAN_CXX11
         template <typename TCharType, typename T0, typename... T>
         inline std::basic_string<TCharType> Format(const TCharType* format, const T0& arg0, T... args)
@@ -175,6 +292,88 @@ namespace Formatting
             sink.assign(Sink.CStr(), Sink.GetLength());
         }
 
+        template <typename TCharType, typename TFormatType, typename T0, typename... T>
+        inline void FormatTo(TChunkedString<TCharType>& sink, const TFormatType& format, const T0& arg0, const T&... args)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            Details::StagedFormatTo<TCharType, GlobalPatternStorageType, TFormatType, TChunkedString<TCharType>, T0, T...>(sink, format, arg0, args...);
+        }
+
+        template <typename TCharType, typename TFormatType, typename T0, typename... T>
+        inline void FormatTo(TFileSink<TCharType>& sink, const TFormatType& format, const T0& arg0, const T&... args)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            Details::FormatTo<TCharType, GlobalPatternStorageType, TFormatType, T0, T...>(sink.GetBuffer(), format, arg0, args...);
+
+            sink.FlushIfFull();
+        }
+
+        /// <summary>
+        /// Formats to segments, the literal text of the format is referenced instead of copied.
+        /// the format must live longer than the sink.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        /// <param name="args">The arguments.</param>
+        template <typename TCharType, typename TFormatType, typename... T>
+        inline void FormatTo(TScatterOutput<TCharType>& sink, const TFormatType& format, const T&... args)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            Details::ScatterFormatTo<TCharType, GlobalPatternStorageType, TFormatType, T...>(sink, format, args...);
+        }
+
+        /// <summary>
+        /// Formats into the buffer of a producer in place, the buffer is handed to the writer thread when it is full.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        /// <param name="args">The arguments.</param>
+        template <typename TCharType, typename TFormatType, typename... T>
+        inline void FormatTo(TAsyncFileProducer<TCharType>& sink, const TFormatType& format, const T&... args)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            Details::FormatTo<TCharType, GlobalPatternStorageType, TFormatType, T...>(sink.GetBuffer(), format, args...);
+
+            sink.SubmitIfFull();
+        }
+
+#if FL_WITH_MAPPED_FILE_SINK
+        /// <summary>
+        /// Formats on the stack of the calling thread and appends the result to a mapped file sink,
+        /// it can be called from many threads at the same time.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format.</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>false if the file can't be extended.</returns>
+        template <typename TCharType, typename TFormatType, typename... T>
+        inline bool FormatTo(TMappedFileSink<TCharType>& sink, const TFormatType& format, const T&... args)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            TAutoString<TCharType> Sink;
+            Details::FormatTo<TCharType, GlobalPatternStorageType, TFormatType, T...>(Sink, format, args...);
+
+            return sink.Write(Sink.CStr(), Sink.GetLength());
+        }
+#endif
+
+        template <typename TCharType, typename TFormatType, typename T0, typename... T>
+        inline std::basic_string<TCharType>& AppendFormat(std::basic_string<TCharType>& sink, const TFormatType& format, const T0& arg0, const T&... args)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+            typedef Details::StandardLibrary::TStringAppender<TCharType>                                                                                SinkType;
+
+            SinkType Sink(sink);
+            Details::StagedFormatTo<TCharType, GlobalPatternStorageType, TFormatType, SinkType, T0, T...>(Sink, format, arg0, args...);
+
+            return sink;
+        }
+
         template <typename TCharType>
         inline std::basic_string<TCharType> Format(const typename Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType>::PatternListType* patterns, const TCharType* format, const size_t length)
         {
@@ -230,6 +429,103 @@ namespace Formatting
 
             return sink;
         }
+
+        /// <summary>
+        /// Formats in single pass mode, the format is parsed and rendered at the same time without the pattern cache.
+        /// use it for formats which are created at runtime and used once, such as user supplied templates.
+        /// </summary>
+        template <typename TCharType, typename... T>
+        inline std::basic_string<TCharType> FormatOnce(const TCharType* format, const T&... args)
+        {
+            TAutoString<TCharType> Sink;
+            Details::FormatOnceTo<TCharType, T...>(Sink, format, TCharTraits<TCharType>::length(format), args...);
+
+            return std::basic_string<TCharType>(Sink.CStr(), Sink.GetLength());
+        }
+
+        template <typename TCharType, typename... T>
+        inline std::basic_string<TCharType> FormatOnce(const std::basic_string<TCharType>& format, const T&... args)
+        {
+            TAutoString<TCharType> Sink;
+            Details::FormatOnceTo<TCharType, T...>(Sink, format.c_str(), format.size(), args...);
+
+            return std::basic_string<TCharType>(Sink.CStr(), Sink.GetLength());
+        }
+
+        template <typename TCharType, typename TFormatType, typename... T>
+        inline void FormatOnceTo(std::basic_string<TCharType>& sink, const TFormatType& format, const T&... args)
+        {
+            sink.clear();
+
+            TAutoString<TCharType> Sink;
+            Details::FormatOnceTo<TCharType, T...>(Sink, Shims::PtrOf(format), Shims::LengthOf(format), args...);
+
+            sink.assign(Sink.CStr(), Sink.GetLength());
+        }
+
+        /// <summary>
+        /// Creates a lazy formatted value, the text is formatted only when it is consumed by
+        /// Format, FormatTo, AppendFormat or a stream. use it for messages which are usually discarded, such as trace logs.
+        /// scalar arguments are copied, the format and the other arguments are referenced and must live longer than the returned object.
+        /// </summary>
+        /// <param name="format">The format.</param>
+        /// <param name="args">The arguments.</param>
+        /// <returns>the lazy formatted value.</returns>
+        template <typename TCharType, typename... T>
+        inline Details::TLazyFormat<TCharType, Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >, T...>
+            Lazy(const TCharType* format, const T&... args)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            return Details::TLazyFormat<TCharType, GlobalPatternStorageType, T...>(format, TCharTraits<TCharType>::length(format), args...);
+        }
+
+        template <typename TCharType, typename... T>
+        inline Details::TLazyFormat<TCharType, Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >, T...>
+            Lazy(const std::basic_string<TCharType>& format, const T&... args)
+        {
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            return Details::TLazyFormat<TCharType, GlobalPatternStorageType, T...>(format.c_str(), format.size(), args...);
+        }
+
+        /// <summary>
+        /// Creates a reader which pulls the text of a lazy formatted value in chunks.
+        /// </summary>
+        /// <param name="lazy">The lazy formatted value, it is copied.</param>
+        /// <returns>the reader.</returns>
+        template <typename TCharType, typename TPatternStorageType, typename... T>
+        inline Details::TFormatReader< Details::TLazyFormat<TCharType, TPatternStorageType, T...> > MakeReader(const Details::TLazyFormat<TCharType, TPatternStorageType, T...>& lazy)
+        {
+            return Details::TFormatReader< Details::TLazyFormat<TCharType, TPatternStorageType, T...> >(lazy);
+        }
+
+        template <typename TCharType, typename TPatternStorageType, typename... T>
+        inline std::basic_string<TCharType> Format(const Details::TLazyFormat<TCharType, TPatternStorageType, T...>& lazy)
+        {
+            TAutoString<TCharType> Sink;
+            lazy.AppendTo(Sink);
+
+            return std::basic_string<TCharType>(Sink.CStr(), Sink.GetLength());
+        }
+
+        template <typename TCharType, typename TPatternStorageType, typename... T>
+        inline void FormatTo(std::basic_string<TCharType>& sink, const Details::TLazyFormat<TCharType, TPatternStorageType, T...>& lazy)
+        {
+            TAutoString<TCharType> Sink;
+            lazy.AppendTo(Sink);
+
+            sink.assign(Sink.CStr(), Sink.GetLength());
+        }
+
+        template <typename TCharType, typename TPatternStorageType, typename... T>
+        inline std::basic_string<TCharType>& AppendFormat(std::basic_string<TCharType>& sink, const Details::TLazyFormat<TCharType, TPatternStorageType, T...>& lazy)
+        {
+            Details::StandardLibrary::TStringAppender<TCharType> Sink(sink);
+            lazy.AppendTo(Sink);
+
+            return sink;
+        }
 #else
 #define FL_TEMPLATE_PARAMETERS_BODY( d, i ) \
     FL_PP_COMMA_IF(i) typename FL_PP_CAT(T, i)
@@ -287,6 +583,33 @@ namespace Formatting
         TAutoString<wchar_t> Results; \
         Details::FormatTo< wchar_t, Details::StandardLibrary::STLGlobalPatternStorageW, const wchar_t*, FL_PP_REPEAT(i, FL_TEMPLATE_AGUMENT_BODY, )>(Results, Shims::PtrOf(format), FL_PP_REPEAT(i, FL_REAL_ARGUMENT_BODY, )); \
         sink.append(Results.CStr(), Results.GetLength()); \
+    } \
+    template < typename TFormatType, FL_PP_REPEAT(i, FL_TEMPLATE_PARAMETERS_BODY, ) > \
+    std::string& AppendFormat(std::string& sink, const TFormatType& format, FL_PP_REPEAT(i, FL_NORMAL_AGUMENT_BODY, )) \
+    { \
+        Details::StandardLibrary::TStringAppender<char> Appender(sink); \
+        Details::StagedFormatTo< char, Details::StandardLibrary::STLGlobalPatternStorageA, const char*, Details::StandardLibrary::TStringAppender<char>, FL_PP_REPEAT(i, FL_TEMPLATE_AGUMENT_BODY, )>(Appender, Shims::PtrOf(format), FL_PP_REPEAT(i, FL_REAL_ARGUMENT_BODY, )); \
+        return sink; \
+    } \
+    template < typename TFormatType, FL_PP_REPEAT(i, FL_TEMPLATE_PARAMETERS_BODY, ) > \
+    std::wstring& AppendFormat(std::wstring& sink, const TFormatType& format, FL_PP_REPEAT(i, FL_NORMAL_AGUMENT_BODY, )) \
+    { \
+        Details::StandardLibrary::TStringAppender<wchar_t> Appender(sink); \
+        Details::StagedFormatTo< wchar_t, Details::StandardLibrary::STLGlobalPatternStorageW, const wchar_t*, Details::StandardLibrary::TStringAppender<wchar_t>, FL_PP_REPEAT(i, FL_TEMPLATE_AGUMENT_BODY, )>(Appender, Shims::PtrOf(format), FL_PP_REPEAT(i, FL_REAL_ARGUMENT_BODY, )); \
+        return sink; \
+    } \
+    template < typename TCharType, typename TFormatType, FL_PP_REPEAT(i, FL_TEMPLATE_PARAMETERS_BODY, ) > \
+    void FormatTo(TFileSink<TCharType>& sink, const TFormatType& format, FL_PP_REPEAT(i, FL_NORMAL_AGUMENT_BODY, )) \
+    { \
+        typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> > GlobalPatternStorageType; \
+        Details::FormatTo< TCharType, GlobalPatternStorageType, const TCharType*, FL_PP_REPEAT(i, FL_TEMPLATE_AGUMENT_BODY, )>(sink.GetBuffer(), Shims::PtrOf(format), FL_PP_REPEAT(i, FL_REAL_ARGUMENT_BODY, )); \
+        sink.FlushIfFull(); \
+    } \
+    template < typename TCharType, typename TFormatType, FL_PP_REPEAT(i, FL_TEMPLATE_PARAMETERS_BODY, ) > \
+    void FormatTo(TChunkedString<TCharType>& sink, const TFormatType& format, FL_PP_REPEAT(i, FL_NORMAL_AGUMENT_BODY, )) \
+    { \
+        typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> > GlobalPatternStorageType; \
+        Details::StagedFormatTo< TCharType, GlobalPatternStorageType, const TCharType*, TChunkedString<TCharType>, FL_PP_REPEAT(i, FL_TEMPLATE_AGUMENT_BODY, )>(sink, Shims::PtrOf(format), FL_PP_REPEAT(i, FL_REAL_ARGUMENT_BODY, )); \
     }
 
         // #pragma message( FL_PP_TEXT((FL_EXPORT_FOR_STRING(1))) )
@@ -302,6 +625,67 @@ namespace Formatting
 #undef FL_NORMAL_AGUMENT_BODY
 #endif
 
+        /// <summary>
+        /// Formats every element of a range with the element format, such as "{0:x8}" or "{0:f3}",
+        /// and joins the results with separator.
+        /// </summary>
+        /// <param name="format">The element format.</param>
+        /// <param name="elements">The elements.</param>
+        /// <param name="count">elements count</param>
+        /// <param name="separator">The separator.</param>
+        /// <returns>the joined string.</returns>
+        template <typename TCharType, typename T>
+        inline std::basic_string<TCharType> FormatJoin(const TCharType* format, const T* elements, const size_t count, const TCharType* separator)
+        {
+            typedef TAutoString<TCharType> SinkType;
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            SinkType Sink;
+            Details::FormatJoinTo<TCharType, GlobalPatternStorageType, const TCharType*, T>(
+                Sink,
+                format,
+                elements,
+                count,
+                separator,
+                separator != nullptr ? TCharTraits<TCharType>::length(separator) : 0
+                );
+
+            return std::basic_string<TCharType>(Sink.CStr(), Sink.GetLength());
+        }
+
+        template <typename TCharType, typename T, typename TAllocator>
+        inline std::basic_string<TCharType> FormatJoin(const TCharType* format, const std::vector<T, TAllocator>& elements, const TCharType* separator)
+        {
+            return FormatJoin<TCharType, T>(format, elements.empty() ? nullptr : &elements[0], elements.size(), separator);
+        }
+
+        template <typename TCharType, typename T>
+        inline void FormatJoinTo(std::basic_string<TCharType>& sink, const TCharType* format, const T* elements, const size_t count, const TCharType* separator)
+        {
+            typedef TAutoString<TCharType> SinkType;
+            typedef Details::TGlobalPatternStorage< Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType> >    GlobalPatternStorageType;
+
+            sink.clear();
+
+            SinkType Sink;
+            Details::FormatJoinTo<TCharType, GlobalPatternStorageType, const TCharType*, T>(
+                Sink,
+                format,
+                elements,
+                count,
+                separator,
+                separator != nullptr ? TCharTraits<TCharType>::length(separator) : 0
+                );
+
+            sink.assign(Sink.CStr(), Sink.GetLength());
+        }
+
+        template <typename TCharType, typename T, typename TAllocator>
+        inline void FormatJoinTo(std::basic_string<TCharType>& sink, const TCharType* format, const std::vector<T, TAllocator>& elements, const TCharType* separator)
+        {
+            FormatJoinTo<TCharType, T>(sink, format, elements.empty() ? nullptr : &elements[0], elements.size(), separator);
+        }
+
 #ifndef FL_DISABLE_STANDARD_LIBARY_MACROS
 #if FL_COMPILER_IS_GREATER_THAN_CXX11
     #define FL_STD_FORMAT(format, ...) \
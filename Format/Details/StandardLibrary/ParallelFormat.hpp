@@ -0,0 +1,306 @@
+/*
+    MIT License
+
+    Copyright (c) 2024 CPPStringFormatting
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Project URL: https://github.com/bodong1987/CPPStringFormatting
+*/
+#pragma once
+
+#include <Format/Details/StandardLibrary/FormatTo.hpp>
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+#include <atomic>
+#include <thread>
+#include <utility>
+
+// Allows users to directly define the record count of a parallel batch task from the outside
+#ifndef FL_BATCH_FORMAT_BLOCK_SIZE
+#define FL_BATCH_FORMAT_BLOCK_SIZE 256
+#endif
+
+namespace Formatting // NOLINT(*-concat-nested-namespaces)
+{
+    namespace Details
+    {
+        namespace StandardLibrary
+        {
+            /// <summary>
+            /// Class TBatchWorkQueue.
+            /// every worker owns a contiguous range of blocks and takes blocks from its front,
+            /// an idle worker steals the back half of the largest other range.
+            /// a range is packed into one 64 bit atomic, so both operations are a single compare exchange.
+            /// </summary>
+            class TBatchWorkQueue : Noncopyable
+            {
+            public:
+                TBatchWorkQueue(const size_t blockCount, const size_t workerCount) :
+                    Ranges(new std::atomic<uint64_t>[workerCount]),
+                    WorkerCount(workerCount)
+                {
+                    for (size_t i = 0; i < workerCount; ++i)
+                    {
+                        Ranges[i].store(Pack(blockCount * i / workerCount, blockCount * (i + 1) / workerCount));
+                    }
+                }
+
+                ~TBatchWorkQueue()
+                {
+                    delete[] Ranges;
+                }
+
+                /// <summary>
+                /// Gets the next block of a worker.
+                /// </summary>
+                /// <param name="worker">The worker.</param>
+                /// <param name="block">The block.</param>
+                /// <returns>false if there is no work left.</returns>
+                bool Next(const size_t worker, size_t& block)
+                {
+                    for (;;)
+                    {
+                        uint64_t Range = Ranges[worker].load();
+
+                        while (Begin(Range) < End(Range))
+                        {
+                            if (Ranges[worker].compare_exchange_weak(Range, Pack(Begin(Range) + 1, End(Range))))
+                            {
+                                block = Begin(Range);
+
+                                return true;
+                            }
+                        }
+
+                        if (!Steal(worker))
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+            private:
+                bool Steal(const size_t worker)
+                {
+                    for (;;)
+                    {
+                        size_t Victim = WorkerCount;
+                        uint64_t VictimRange = 0;
+
+                        for (size_t i = 0; i < WorkerCount; ++i)
+                        {
+                            const uint64_t Range = Ranges[i].load();
+
+                            if (i != worker && End(Range) - Begin(Range) > End(VictimRange) - Begin(VictimRange))
+                            {
+                                Victim = i;
+                                VictimRange = Range;
+                            }
+                        }
+
+                        if (Victim == WorkerCount)
+                        {
+                            return false;
+                        }
+
+                        const uint32_t Middle = End(VictimRange) - (End(VictimRange) - Begin(VictimRange) + 1) / 2;
+
+                        if (Ranges[Victim].compare_exchange_strong(VictimRange, Pack(Begin(VictimRange), Middle)))
+                        {
+                            // only the owner adds work to its own range, and its range is empty now
+                            Ranges[worker].store(Pack(Middle, End(VictimRange)));
+
+                            return true;
+                        }
+                    }
+                }
+
+                static uint64_t Pack(const size_t begin, const size_t end)
+                {
+                    return (static_cast<uint64_t>(begin) << 32) | static_cast<uint64_t>(end);
+                }
+
+                static uint32_t Begin(const uint64_t range)
+                {
+                    return static_cast<uint32_t>(range >> 32);
+                }
+
+                static uint32_t End(const uint64_t range)
+                {
+                    return static_cast<uint32_t>(range);
+                }
+
+            private:
+                std::atomic<uint64_t>*  Ranges;
+                size_t                  WorkerCount;
+            };
+
+            /// <summary>
+            /// Formats the records of a block, the shared pattern list is only read.
+            /// </summary>
+            template <typename TCharType, typename TPatternListType, typename TArgumentProvider>
+            inline void FormatBatchBlock(
+                TAutoString<TCharType>& sink,
+                const TPatternListType& patterns,
+                const TCharType* format,
+                const size_t recordStart,
+                const size_t recordEnd,
+                TArgumentProvider& provider
+                )
+            {
+                typedef typename std::decay<decltype(provider(size_t()))>::type ArgumentTupleType;
+
+                enum : size_t
+                {
+                    ArgumentCount = std::tuple_size<ArgumentTupleType>::value
+                };
+
+                for (size_t Record = recordStart; Record < recordEnd; ++Record)
+                {
+                    const ArgumentTupleType Arguments = provider(Record);
+
+                    // the last one makes sure the array is not empty
+                    Utils::TErasedArgument<TCharType> ErasedArguments[ArgumentCount + 1] = {};
+                    Utils::TErasedTupleBuilder<TCharType, 0, ArgumentCount>::Build(ErasedArguments, Arguments);
+
+                    Utils::TStreamingRenderer<TCharType> Renderer(sink, format, ErasedArguments, ArgumentCount);
+
+                    typename TPatternListType::ConstIterator Iter(patterns);
+
+                    while (Iter.IsValid())
+                    {
+                        Renderer.Render(*Iter);
+
+                        Iter.Next();
+                    }
+                }
+            }
+        }
+    }
+
+    namespace StandardLibrary
+    {
+        /// <summary>
+        /// Formats many records with the same format on several threads and appends the results to sink in record order.
+        /// the format is parsed once and the pattern list is shared by all workers,
+        /// the records are split into blocks of FL_BATCH_FORMAT_BLOCK_SIZE which are balanced by work stealing.
+        /// provider(index) returns a std::tuple of the arguments of a record, it is called from several threads and must not throw.
+        /// </summary>
+        /// <param name="sink">The sink.</param>
+        /// <param name="format">The format of one record.</param>
+        /// <param name="recordCount">The record count.</param>
+        /// <param name="provider">The argument provider.</param>
+        /// <param name="threadCount">The thread count, 0 means the hardware concurrency. the calling thread is one of them.</param>
+        template <typename TCharType, typename TArgumentProvider>
+        inline void FormatBatchParallel(
+            std::basic_string<TCharType>& sink,
+            const TCharType* format,
+            const size_t recordCount,
+            TArgumentProvider provider,
+            size_t threadCount = 0
+            )
+        {
+            typedef Details::StandardLibrary::TStandardPolicy<TCharType, Details::StandardLibrary::DefaultMutexType>   PolicyType;
+            typedef typename PolicyType::PatternListType                                                            PatternListType;
+
+            const size_t Length = TCharTraits<TCharType>::length(format);
+            const PatternListType Patterns = Details::TPatternParser<PolicyType>::Parse(format, Length);
+
+            const size_t BlockCount = (recordCount + FL_BATCH_FORMAT_BLOCK_SIZE - 1) / FL_BATCH_FORMAT_BLOCK_SIZE;
+
+            assert(BlockCount <= 0xFFFFFFFFu && "too many records");
+
+            if (threadCount == 0)
+            {
+                threadCount = Algorithm::Max<size_t>(std::thread::hardware_concurrency(), 1);
+            }
+
+            threadCount = Algorithm::Min(threadCount, BlockCount);
+
+            if (threadCount <= 1)
+            {
+                TAutoString<TCharType> Sink;
+                Details::StandardLibrary::FormatBatchBlock(Sink, Patterns, format, 0, recordCount, provider);
+
+                sink.append(Sink.CStr(), Sink.GetLength());
+
+                return;
+            }
+
+            std::vector< TAutoString<TCharType> > Blocks(BlockCount);
+            Details::StandardLibrary::TBatchWorkQueue Queue(BlockCount, threadCount);
+
+            const auto Work = [&](const size_t worker)
+            {
+                size_t Block = 0;
+
+                while (Queue.Next(worker, Block))
+                {
+                    const size_t RecordStart = Block * FL_BATCH_FORMAT_BLOCK_SIZE;
+                    const size_t RecordEnd = Algorithm::Min(RecordStart + FL_BATCH_FORMAT_BLOCK_SIZE, recordCount);
+
+                    Details::StandardLibrary::FormatBatchBlock(Blocks[Block], Patterns, format, RecordStart, RecordEnd, provider);
+                }
+            };
+
+            std::vector<std::thread> Workers;
+            Workers.reserve(threadCount - 1);
+
+            for (size_t i = 1; i < threadCount; ++i)
+            {
+                Workers.push_back(std::thread(Work, i));
+            }
+
+            Work(0);
+
+            for (size_t i = 0; i < Workers.size(); ++i)
+            {
+                Workers[i].join();
+            }
+
+            size_t TotalLength = 0;
+
+            for (size_t i = 0; i < Blocks.size(); ++i)
+            {
+                TotalLength += Blocks[i].GetLength();
+            }
+
+            sink.reserve(sink.size() + TotalLength);
+
+            for (size_t i = 0; i < Blocks.size(); ++i)
+            {
+                sink.append(Blocks[i].CStr(), Blocks[i].GetLength());
+            }
+        }
+
+        template <typename TCharType, typename TArgumentProvider>
+        inline void FormatBatchParallel(
+            std::basic_string<TCharType>& sink,
+            const std::basic_string<TCharType>& format,
+            const size_t recordCount,
+            TArgumentProvider provider,
+            const size_t threadCount = 0
+            )
+        {
+            FormatBatchParallel(sink, format.c_str(), recordCount, provider, threadCount);
+        }
+    }
+}
+#endif
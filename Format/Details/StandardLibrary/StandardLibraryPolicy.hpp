@@ -42,6 +42,52 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
     {
         namespace StandardLibrary
         {
+            /// <summary>
+            /// Class TPatternList.
+            /// pattern list of the stl policy, it learns the output length of its format.
+            /// </summary>
+            template <typename TCharType>
+            class TPatternList :
+                public TAutoArray<TFormatPattern<TCharType>, 0xF, 0>
+            {
+            public:
+                TPatternList() :
+                    LengthHint(0)
+                {
+                }
+
+                size_t GetLengthHint() const  // NOLINT(modernize-use-nodiscard)
+                {
+                    return LengthHint;
+                }
+
+                /// <summary>
+                /// Updates the length hint with an exponentially weighted moving average, the new length has weight 1/4.
+                /// patterns are const after they are cached, so the hint is mutable.
+                /// </summary>
+                /// <param name="length">The output length.</param>
+                void UpdateLengthHint(const size_t length) const
+                {
+                    LengthHint = LengthHint == 0 ? length : LengthHint - LengthHint / 4 + length / 4;
+                }
+
+            private:
+                mutable size_t                                                 LengthHint;
+            };
+
+            // found by argument dependent lookup, see Details::GetLengthHint
+            template <typename TCharType>
+            inline size_t GetLengthHint(const TPatternList<TCharType>& patterns)
+            {
+                return patterns.GetLengthHint();
+            }
+
+            template <typename TCharType>
+            inline void UpdateLengthHint(const TPatternList<TCharType>& patterns, const size_t length)
+            {
+                patterns.UpdateLengthHint(length);
+            }
+
             /// <summary>
             /// Class TStandardPolicy.
             /// stl default policy
@@ -54,7 +100,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                 typedef TFormatPattern<CharType>                               FormatPattern;
                 typedef typename FormatPattern::SizeType                       SizeType;
                 typedef typename FormatPattern::ByteType                       ByteType;
-                typedef TAutoArray<FormatPattern, 0xF, 0>                      PatternListType; // NOLINT
+                typedef TPatternList<CharType>                                 PatternListType; // NOLINT
                 typedef typename PatternListType::ConstIterator                PatternIterator;
                 typedef std::runtime_error                                     ExceptionType;
                 typedef TMutexType                                             MutexType;
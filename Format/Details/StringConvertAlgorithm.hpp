@@ -35,6 +35,10 @@
 #include <Format/Common/Mpl.hpp>
 #include "Format/Common/Algorithm.hpp"
 
+#if FL_WITH_SSE2
+#include <emmintrin.h>
+#endif
+
 // ReSharper disable once CppEnforceNestedNamespacesStyle
 namespace Formatting // NOLINT(*-concat-nested-namespaces)
 {
@@ -58,33 +62,6 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             }
         }
 
-        /// <summary>
-        /// Integers to binary string.
-        /// </summary>
-        /// <param name="value">The value.</param>
-        /// <param name="buffer">The buffer.</param>
-        template <typename TCharType, typename TIntegerType>
-        inline int IntegerToBinaryString(TIntegerType value, TCharType buffer[sizeof(TIntegerType) * 8 + 1])
-        {
-            constexpr int length = sizeof(TIntegerType) * 8;
-
-            buffer[length] = TCharTraits<TCharType>::GetEndFlag();
-
-            for (int i = length-1; i >= 0; --i)
-            {
-                buffer[i] = (value&1) + TCharTraits<TCharType>::GetZero();
-
-                value >>= 1;
-
-                if (value == 0)
-                {
-                    return length - i;
-                }
-            }
-
-            return length;
-        }
-
         namespace  Utils
         {
             template <typename TCharType, typename TIntegerType, int32_t Base, bool IsSignedInteger>  // NOLINT
@@ -190,6 +167,284 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                 }
             };
 
+            /// <summary>
+            /// Gets the decimal digit pairs table, "00" "01" ... "99".
+            /// two digits are emitted per division, which halves the number of divisions.
+            /// </summary>
+            /// <returns>the table text</returns>
+            inline const char* GetDecimalDigitPairs()
+            {
+                constexpr static char DigitPairs[] =
+                    "00010203040506070809"
+                    "10111213141516171819"
+                    "20212223242526272829"
+                    "30313233343536373839"
+                    "40414243444546474849"
+                    "50515253545556575859"
+                    "60616263646566676869"
+                    "70717273747576777879"
+                    "80818283848586878889"
+                    "90919293949596979899";
+
+                return DigitPairs;
+            }
+
+            /// <summary>
+            /// Writes the decimal digits of value backward, the last digit is written to end[-1].
+            /// </summary>
+            /// <param name="end">The end position.</param>
+            /// <param name="value">The value.</param>
+            template <typename TCharType>
+            inline void WriteDecimalDigitsBackward(TCharType* end, uint32_t value)
+            {
+                const char* const DigitPairs = GetDecimalDigitPairs();
+
+                while (value >= 100)
+                {
+                    const uint32_t Index = (value % 100) * 2;
+                    value /= 100;
+
+                    *--end = static_cast<TCharType>(DigitPairs[Index + 1]);
+                    *--end = static_cast<TCharType>(DigitPairs[Index]);
+                }
+
+                if (value >= 10)
+                {
+                    *--end = static_cast<TCharType>(DigitPairs[value * 2 + 1]);
+                    *--end = static_cast<TCharType>(DigitPairs[value * 2]);
+                }
+                else
+                {
+                    *--end = static_cast<TCharType>(TCharTraits<TCharType>::GetZero() + value);
+                }
+            }
+
+            /// <summary>
+            /// Writes the decimal digits of value backward, the last digit is written to end[-1].
+            /// 64bit divisions are only used while the value does not fit into 32bit.
+            /// </summary>
+            /// <param name="end">The end position.</param>
+            /// <param name="value">The value.</param>
+            template <typename TCharType>
+            inline void WriteDecimalDigitsBackward(TCharType* end, uint64_t value)
+            {
+                const char* const DigitPairs = GetDecimalDigitPairs();
+
+                while (value > 0xFFFFFFFFU)
+                {
+                    const uint32_t Index = static_cast<uint32_t>(value % 100) * 2;
+                    value /= 100;
+
+                    *--end = static_cast<TCharType>(DigitPairs[Index + 1]);
+                    *--end = static_cast<TCharType>(DigitPairs[Index]);
+                }
+
+                WriteDecimalDigitsBackward(end, static_cast<uint32_t>(value));
+            }
+
+            /// <summary>
+            /// Gets the hex digit pairs table, one entry of two characters for every byte value.
+            /// </summary>
+            /// <param name="upper">use upper case letters.</param>
+            /// <returns>the table text</returns>
+            inline const char* GetHexDigitPairs(const bool upper)
+            {
+                constexpr static char DigitPairsLower[] =
+                    "000102030405060708090a0b0c0d0e0f"
+                    "101112131415161718191a1b1c1d1e1f"
+                    "202122232425262728292a2b2c2d2e2f"
+                    "303132333435363738393a3b3c3d3e3f"
+                    "404142434445464748494a4b4c4d4e4f"
+                    "505152535455565758595a5b5c5d5e5f"
+                    "606162636465666768696a6b6c6d6e6f"
+                    "707172737475767778797a7b7c7d7e7f"
+                    "808182838485868788898a8b8c8d8e8f"
+                    "909192939495969798999a9b9c9d9e9f"
+                    "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+                    "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+                    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+                    "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+                    "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+                    "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+                constexpr static char DigitPairsUpper[] =
+                    "000102030405060708090A0B0C0D0E0F"
+                    "101112131415161718191A1B1C1D1E1F"
+                    "202122232425262728292A2B2C2D2E2F"
+                    "303132333435363738393A3B3C3D3E3F"
+                    "404142434445464748494A4B4C4D4E4F"
+                    "505152535455565758595A5B5C5D5E5F"
+                    "606162636465666768696A6B6C6D6E6F"
+                    "707172737475767778797A7B7C7D7E7F"
+                    "808182838485868788898A8B8C8D8E8F"
+                    "909192939495969798999A9B9C9D9E9F"
+                    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+                    "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+                    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+                    "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+                    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+                    "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+                return upper ? DigitPairsUpper : DigitPairsLower;
+            }
+
+            /// <summary>
+            /// Gets the binary digits table, one entry of four characters for every nibble value.
+            /// </summary>
+            /// <returns>the table text</returns>
+            inline const char* GetBinaryNibbles()
+            {
+                constexpr static char Nibbles[] =
+                    "0000000100100011010001010110011110001001101010111100110111101111";
+
+                return Nibbles;
+            }
+
+            /// <summary>
+            /// Writes the hex digits of value backward, the last digit is written to end[-1].
+            /// </summary>
+            /// <param name="end">The end position.</param>
+            /// <param name="value">The value.</param>
+            /// <param name="digits">The digits count, leading zeros are written if it is larger than the significant digits.</param>
+            /// <param name="upper">use upper case letters.</param>
+            template <typename TCharType, typename TUnsignedType>
+            inline void WriteHexDigitsBackward(TCharType* end, TUnsignedType value, int32_t digits, const bool upper)
+            {
+                const char* const DigitPairs = GetHexDigitPairs(upper);
+
+                for (; digits >= 2; digits -= 2)
+                {
+                    const uint32_t Index = static_cast<uint32_t>(value & 0xFF) * 2;
+                    value = static_cast<TUnsignedType>(value >> 8);
+
+                    *--end = static_cast<TCharType>(DigitPairs[Index + 1]);
+                    *--end = static_cast<TCharType>(DigitPairs[Index]);
+                }
+
+                if (digits > 0)
+                {
+                    *--end = static_cast<TCharType>(DigitPairs[static_cast<uint32_t>(value & 0xF) * 2 + 1]);
+                }
+            }
+
+#if FL_WITH_SSE2
+            /// <summary>
+            /// Writes the hex digits of a 64bit value backward with SSE2,
+            /// all 16 digits are expanded with a few vector instructions, then the required tail is copied.
+            /// </summary>
+            /// <param name="end">The end position.</param>
+            /// <param name="value">The value.</param>
+            /// <param name="digits">The digits count.</param>
+            /// <param name="upper">use upper case letters.</param>
+            inline void WriteHexDigitsBackward(char* end, uint64_t value, int32_t digits, const bool upper)
+            {
+                // short values are cheaper with the table
+                if (digits <= 8)
+                {
+                    WriteHexDigitsBackward<char, uint32_t>(end, static_cast<uint32_t>(value), digits, upper);
+                    return;
+                }
+
+                // put the most significant byte first
+                uint64_t Swapped = 0;
+                for (int32_t i = 0; i < 8; ++i)
+                {
+                    Swapped = (Swapped << 8) | ((value >> (i * 8)) & 0xFF);
+                }
+
+                const __m128i Input = _mm_set_epi64x(0, static_cast<long long>(Swapped));
+                const __m128i Mask = _mm_set1_epi8(0x0F);
+                const __m128i High = _mm_and_si128(_mm_srli_epi16(Input, 4), Mask);
+                const __m128i Low = _mm_and_si128(Input, Mask);
+                const __m128i Nibbles = _mm_unpacklo_epi8(High, Low);
+
+                // '0' + n, and add the distance to 'a' or 'A' for letters
+                const __m128i Letters = _mm_cmpgt_epi8(Nibbles, _mm_set1_epi8(9));
+                const __m128i Text = _mm_add_epi8(
+                    _mm_add_epi8(Nibbles, _mm_set1_epi8('0')),
+                    _mm_and_si128(Letters, _mm_set1_epi8(upper ? 'A' - '0' - 10 : 'a' - '0' - 10))
+                    );
+
+                char Temp[16];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(Temp), Text);
+
+                TCharTraits<char>::copy(end - digits, Temp + 16 - digits, digits);
+            }
+#endif
+
+            template <bool IsSignedInteger>
+            struct NegativeTester
+            {
+                template <typename TIntegerType>
+                static bool IsNegative(TIntegerType value)
+                {
+                    return value < 0;
+                }
+            };
+
+            template <>
+            struct NegativeTester<false>
+            {
+                template <typename TIntegerType>
+                static bool IsNegative(TIntegerType)
+                {
+                    return false;
+                }
+            };
+        }
+
+        /// <summary>
+        /// Counts the decimal digits.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>the digits count, at least 1.</returns>
+        inline int32_t CountDecimalDigits(uint32_t value)
+        {
+            int32_t Count = 1;
+
+            for (;;)
+            {
+                if (value < 10)
+                {
+                    return Count;
+                }
+
+                if (value < 100)
+                {
+                    return Count + 1;
+                }
+
+                if (value < 1000)
+                {
+                    return Count + 2;
+                }
+
+                if (value < 10000)
+                {
+                    return Count + 3;
+                }
+
+                value /= 10000U;
+                Count += 4;
+            }
+        }
+
+        /// <summary>
+        /// Counts the decimal digits.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>the digits count, at least 1.</returns>
+        inline int32_t CountDecimalDigits(uint64_t value)
+        {
+            int32_t Count = 0;
+
+            while (value > 0xFFFFFFFFU)
+            {
+                value /= 10000U;
+                Count += 4;
+            }
+
+            return Count + CountDecimalDigits(static_cast<uint32_t>(value));
         }
 
         /// <summary>
@@ -275,6 +530,135 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             return buffer;
         }
 
+        /// <summary>
+        /// Integer to decimal string.
+        /// the digits count is calculated first, so the text is written to its final position directly,
+        /// integers no wider than 32bit never use 64bit divisions.
+        /// the buffer is not terminated.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <param name="buffer">The buffer, must hold all digits of the type plus the sign.</param>
+        /// <returns>the written length</returns>
+        template < typename TCharType, typename TIntegerType >
+        inline size_t IntegerToDecimalString(TIntegerType value, TCharType* const buffer)
+        {
+            typedef typename Mpl::UnsignedTypeOf<TIntegerType>::Type                 UnsignedType;
+            typedef typename Mpl::IfElse<
+                sizeof(TIntegerType) <= sizeof(uint32_t),
+                uint32_t,
+                uint64_t
+            >::Type                                                                 KernelType;
+
+            const bool IsNegativeNumber = Utils::NegativeTester<Mpl::IsSigned<TIntegerType>::Value>::IsNegative(value);
+
+            // negate in the unsigned domain, so the minimum value will not overflow.
+            const KernelType Magnitude = IsNegativeNumber ?
+                static_cast<KernelType>(static_cast<UnsignedType>(0U - static_cast<UnsignedType>(value))) :
+                static_cast<KernelType>(static_cast<UnsignedType>(value));
+
+            const int32_t Digits = CountDecimalDigits(Magnitude);
+
+            TCharType* Str = buffer;
+
+            if (IsNegativeNumber)
+            {
+                *Str++ = '-';
+            }
+
+            Utils::WriteDecimalDigitsBackward(Str + Digits, Magnitude);
+
+            return static_cast<size_t>(Str + Digits - buffer);
+        }
+
+        /// <summary>
+        /// Integer to hex string.
+        /// two digits are emitted per byte from a lookup table,
+        /// negative numbers are written as the sign and the magnitude.
+        /// the buffer is not terminated.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <param name="buffer">The buffer, must hold sizeof(TIntegerType) * 2 digits plus the sign.</param>
+        /// <param name="upper">use upper case letters.</param>
+        /// <param name="minDigits">leading zeros are written until there are minDigits digits, at most sizeof(TIntegerType) * 2.</param>
+        /// <returns>the written length</returns>
+        template < typename TCharType, typename TIntegerType >
+        inline size_t IntegerToHexString(TIntegerType value, TCharType* const buffer, const bool upper, const int32_t minDigits = 1)
+        {
+            typedef typename Mpl::UnsignedTypeOf<TIntegerType>::Type                 UnsignedType;
+
+            const bool IsNegativeNumber = Utils::NegativeTester<Mpl::IsSigned<TIntegerType>::Value>::IsNegative(value);
+
+            const UnsignedType Magnitude = IsNegativeNumber ?
+                static_cast<UnsignedType>(0U - static_cast<UnsignedType>(value)) :
+                static_cast<UnsignedType>(value);
+
+            int32_t Digits = 0;
+            UnsignedType Rest = Magnitude;
+
+            while (Rest > 0xFF)
+            {
+                Rest = static_cast<UnsignedType>(Rest >> 8);
+                Digits += 2;
+            }
+
+            Digits += Rest > 0xF ? 2 : 1;
+
+            Digits = Algorithm::Max(Digits, Algorithm::Min(minDigits, static_cast<int32_t>(sizeof(TIntegerType) * 2)));
+
+            TCharType* Str = buffer;
+
+            if (IsNegativeNumber)
+            {
+                *Str++ = '-';
+            }
+
+            Utils::WriteHexDigitsBackward(Str + Digits, Magnitude, Digits, upper);
+
+            return static_cast<size_t>(Str + Digits - buffer);
+        }
+
+        /// <summary>
+        /// Integers to binary string.
+        /// four digits are emitted per nibble from a lookup table,
+        /// negative numbers are written as two's complement.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <param name="buffer">The buffer.</param>
+        /// <returns>the written length, the text is at the end of the buffer.</returns>
+        template <typename TCharType, typename TIntegerType>
+        inline int IntegerToBinaryString(TIntegerType value, TCharType buffer[sizeof(TIntegerType) * 8 + 1])
+        {
+            typedef typename Mpl::UnsignedTypeOf<TIntegerType>::Type                 UnsignedType;
+
+            constexpr int length = sizeof(TIntegerType) * 8;
+            const char* const Nibbles = Utils::GetBinaryNibbles();
+
+            buffer[length] = TCharTraits<TCharType>::GetEndFlag();
+
+            UnsignedType UValue = static_cast<UnsignedType>(value);
+            TCharType* Str = buffer + length;
+
+            do
+            {
+                const char* const Bits = Nibbles + (UValue & 0xF) * 4;
+
+                *--Str = static_cast<TCharType>(Bits[3]);
+                *--Str = static_cast<TCharType>(Bits[2]);
+                *--Str = static_cast<TCharType>(Bits[1]);
+                *--Str = static_cast<TCharType>(Bits[0]);
+
+                UValue = static_cast<UnsignedType>(UValue >> 4);
+            } while (UValue != 0);
+
+            // only the highest nibble can have leading zeros
+            while (Str < buffer + length - 1 && *Str == TCharTraits<TCharType>::GetZero())
+            {
+                ++Str;
+            }
+
+            return static_cast<int>(buffer + length - Str);
+        }
+
         /// <summary>
         /// Doubles to string.
         /// </summary>
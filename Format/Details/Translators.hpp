@@ -113,6 +113,78 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                     fillChar
                     );
             }
+
+            /// <summary>
+            /// Commits the text which is written to the space returned by strRef.Reserve.
+            /// the text is moved in place only when it is padded on the left.
+            /// </summary>
+            static void CommitString(
+                StringType& strRef,
+                CharType* start,
+                const SizeType length,
+                const SizeType alignSize,
+                bool paddingLeft,
+                CharType fillChar = CharTraits::GetSpace()
+                )
+            {
+                if (alignSize <= length)
+                {
+                    strRef.Commit(length);
+
+                    return;
+                }
+
+                const SizeType PaddingCount = alignSize - length;
+
+                if (paddingLeft)
+                {
+                    CharTraits::move(start + PaddingCount, start, length);
+                    CharTraits::Fill(start, fillChar, PaddingCount);
+                }
+                else
+                {
+                    CharTraits::Fill(start + length, fillChar, PaddingCount);
+                }
+
+                strRef.Commit(alignSize);
+            }
+
+            static void CommitString(
+                StringType& strRef,
+                const FormatPattern& pattern,
+                CharType* start,
+                const SizeType length
+                )
+            {
+                CommitString(
+                    strRef,
+                    start,
+                    length,
+                    pattern.HasWidth() ? static_cast<SizeType>(pattern.Width) : length,
+                    pattern.Align != EAlignFlag::Left
+                    );
+            }
+
+            /// <summary>
+            /// Gets the length should be reserved for a number of this pattern.
+            /// </summary>
+            static SizeType GetReservedLength(const FormatPattern& pattern, const SizeType maxLength)
+            {
+                SizeType Length = maxLength;
+
+                if (pattern.HasWidth())
+                {
+                    Length = Algorithm::Max(Length, static_cast<SizeType>(pattern.Width));
+                }
+
+                if (pattern.HasPrecision())
+                {
+                    // one more for the sign
+                    Length = Algorithm::Max(Length, static_cast<SizeType>(pattern.Precision) + 1);
+                }
+
+                return Length;
+            }
         };
 
         /// <summary>
@@ -436,75 +508,79 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             typedef typename Super::StringType                          StringType;
             typedef typename Super::CharTraits                          CharTraits;
 
-        private:
-            static bool TransferGeneral(StringType& strRef, const FormatPattern& pattern, ParameterType arg)
+            enum  // NOLINT(performance-enum-size)
             {
-                const bool bHex = pattern.Flag == EFormatFlag::Hex;
+                // digits of the widest value of this type, plus the sign
+                MaxDecimalLength = TMaxLength<static_cast<uint64_t>(static_cast<typename Mpl::UnsignedTypeOf<TIntegerType>::Type>(-1))>::Value + 1,
+                MaxHexDigits = sizeof(TIntegerType) * 2
+            };
 
-                CharType TempBuf[32];
+        private:
+            // the number is written to the space reserved from strRef, so it is not copied again
+            static void CommitNumber(StringType& strRef, const FormatPattern& pattern, CharType* text, const SizeType length)
+            {
+                // the sign is placed before the leading zeros, the precision counts the digits only
+                const bool IsNegativeNumber = length > 0 && text[0] == '-';
+                const SizeType DigitsLength = length - IsNegativeNumber;
+                SizeType NumberLength = length;
 
-                const CharType* const Result = bHex ?
-                    IntegerToString<CharType, ParameterType, 16>(
-                        arg,
-                        TempBuf,
-                        FL_ARRAY_COUNTOF(TempBuf),
-                        pattern.IsUpper
-                        ) :
-                    IntegerToString<CharType, ParameterType, 10>(
-                        arg,
-                        TempBuf,
-                        FL_ARRAY_COUNTOF(TempBuf),
-                        pattern.IsUpper
-                        );
+                if (pattern.HasPrecision() && pattern.Precision > DigitsLength)
+                {
+                    const SizeType PaddingCount = pattern.Precision - DigitsLength;
+                    CharType* const Digits = text + IsNegativeNumber;
 
-                const SizeType length = CalculateConvertedStringLength(Result, TempBuf);
+                    CharTraits::move(Digits + PaddingCount, Digits, DigitsLength);
+                    CharTraits::Fill(Digits, CharTraits::GetZero(), PaddingCount);
 
-                if (pattern.HasPrecision() && pattern.Precision > length)
-                {
-                    Super::AppendString(
-                        strRef,
-                        pattern,
-                        Result,
-                        length,
-                        pattern.Precision,
-                        true,
-                        CharTraits::GetZero()
-                        );
-                }
-                else
-                {
-                    Super::AppendString(strRef, pattern, Result, length);
+                    NumberLength = IsNegativeNumber + pattern.Precision;
                 }
 
+                // the width is applied to the zero padded number
+                Super::CommitString(strRef, pattern, text, NumberLength);
+            }
+
+            static bool TransferDecimal(StringType& strRef, const FormatPattern& pattern, ParameterType arg)
+            {
+                CharType* const Text = strRef.Reserve(Super::GetReservedLength(pattern, MaxDecimalLength));
+
+                const SizeType length = static_cast<SizeType>(IntegerToDecimalString(arg, Text));
+
+                CommitNumber(strRef, pattern, Text, length);
+
+                return true;
+            }
+
+            static bool TransferHex(StringType& strRef, const FormatPattern& pattern, ParameterType arg)
+            {
+                CharType* const Text = strRef.Reserve(Super::GetReservedLength(pattern, MaxHexDigits + 1));
+
+                // precision in the native width is written by the kernel directly
+                const SizeType length = static_cast<SizeType>(
+                    IntegerToHexString(
+                        arg,
+                        Text,
+                        pattern.IsUpper,
+                        pattern.HasPrecision() ? static_cast<int32_t>(pattern.Precision) : 1
+                        )
+                    );
+
+                CommitNumber(strRef, pattern, Text, length);
+
                 return true;
             }
 
             static bool TransferBinary(StringType& strRef, const FormatPattern& pattern, ParameterType arg)
             {
                 constexpr int length = sizeof(ParameterType) * 8;
-                CharType TempBuf[length + 1];
+                CharType* const Text = strRef.Reserve(Super::GetReservedLength(pattern, length + 1));
 
+                // the kernel writes at the end of the buffer
                 const int usedLength =
-                    IntegerToBinaryString<TCharType, ParameterType>(static_cast<ParameterType>(arg), TempBuf);
+                    IntegerToBinaryString<TCharType, ParameterType>(static_cast<ParameterType>(arg), Text);
 
-                const TCharType* const Result = TempBuf + (length - usedLength);
+                CharTraits::move(Text, Text + (length - usedLength), usedLength);
 
-                if (pattern.HasPrecision() && pattern.Precision > usedLength)
-                {
-                    Super::AppendString(
-                        strRef,
-                        pattern,
-                        Result,
-                        usedLength,
-                        pattern.Precision,
-                        true,
-                        CharTraits::GetZero()
-                        );
-                }
-                else
-                {
-                    Super::AppendString(strRef, pattern, Result, usedLength);
-                }
+                CommitNumber(strRef, pattern, Text, usedLength);
 
                 return true;
             }
@@ -516,9 +592,10 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                 {
                 case EFormatFlag::General:
                 case EFormatFlag::Decimal:
-                case EFormatFlag::Hex:
                 case EFormatFlag::None:
-                    return TransferGeneral(strRef, pattern, arg);
+                    return TransferDecimal(strRef, pattern, arg);
+                case EFormatFlag::Hex:
+                    return TransferHex(strRef, pattern, arg);
                 case EFormatFlag::Exponent:
                     return TTranslator<TCharType, double>::Transfer(strRef, pattern, static_cast<double>(arg));
                 case EFormatFlag::FixedPoint:
@@ -533,61 +610,6 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             }
         };
 
-        /// <summary>
-        /// Int64 to string
-        /// Implements the <see cref="TTranslatorBase{TCharType, int64_t}" />
-        /// </summary>
-        /// <seealso cref="TTranslatorBase{TCharType, int64_t}" />
-        template < typename TCharType >
-        class TTranslator< TCharType, int64_t > :
-            public TTranslatorBase< TCharType, int64_t >
-        {
-        public:
-            typedef TTranslatorBase< TCharType, int64_t >               Super;
-            typedef typename Super::CharType                            CharType;
-            typedef typename Super::FormatPattern                       FormatPattern;
-            typedef typename Super::ByteType                            ByteType;
-            typedef typename Super::SizeType                            SizeType;
-            typedef typename Super::StringType                          StringType;
-            typedef typename Super::CharTraits                          CharTraits;
-
-            /// <summary>
-            /// Transfers the specified string reference.
-            /// </summary>
-            /// <param name="strRef">The string reference.</param>
-            /// <param name="pattern">The pattern.</param>
-            /// <param name="arg">The argument.</param>
-            /// <returns>bool.</returns>
-            static bool Transfer(StringType& strRef, const FormatPattern& pattern, int64_t arg)
-            {
-                return TIntegerTranslatorImpl<TCharType, int64_t>::Transfer(strRef, pattern, arg);
-            }
-        };
-
-        /// <summary>
-        /// uint64 to string
-        /// Implements the <see cref="TTranslatorBase{TCharType, uint64_t}" />
-        /// </summary>
-        /// <seealso cref="TTranslatorBase{TCharType, uint64_t}" />
-        template < typename TCharType >
-        class TTranslator< TCharType, uint64_t > :
-            public TTranslatorBase< TCharType, uint64_t >
-        {
-        public:
-            typedef TTranslatorBase< TCharType, uint64_t >              Super;
-            typedef typename Super::CharType                            CharType;
-            typedef typename Super::FormatPattern                       FormatPattern;
-            typedef typename Super::ByteType                            ByteType;
-            typedef typename Super::SizeType                            SizeType;
-            typedef typename Super::StringType                          StringType;
-            typedef typename Super::CharTraits                          CharTraits;
-
-            static bool Transfer(StringType& strRef, const FormatPattern& pattern, uint64_t arg)
-            {
-                return TIntegerTranslatorImpl<TCharType, uint64_t>::Transfer(strRef, pattern, arg);
-            }
-        };
-
         /// <summary>
         /// const char* to string
         /// Implements the <see cref="TTranslatorBase{TCharType, const TCharType*}" />
@@ -651,49 +673,29 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
                 const bool bHex = pattern.Flag == EFormatFlag::Hex || pattern.Flag == EFormatFlag::None;
                 const size_t arg = reinterpret_cast<size_t>(ptr); // NOLINT(*-use-auto)
 
-                CharType TempBuf[32];
-                const CharType* const Result = bHex ?
-                        IntegerToString<CharType, size_t, 16>(
-                            arg,
-                            TempBuf,
-                            FL_ARRAY_COUNTOF(TempBuf),
-                            pattern.IsUpper
-                            ) :
-                        IntegerToString<CharType, size_t, 10>(
-                            arg,
-                            TempBuf,
-                            FL_ARRAY_COUNTOF(TempBuf),
-                            pattern.IsUpper
-                            );
+                constexpr size_t defaultAlignedLength = sizeof(void*)*2;
 
-                const SizeType length = CalculateConvertedStringLength(Result, TempBuf);
+                CharType* const Text = strRef.Reserve(
+                    Algorithm::Max(
+                        static_cast<SizeType>(TMaxLength<static_cast<uint64_t>(static_cast<size_t>(-1))>::Value),
+                        pattern.HasPrecision() ? static_cast<SizeType>(pattern.Precision) : 0
+                        )
+                    );
 
-                if (pattern.HasPrecision() && pattern.Precision > length)
-                {
-                    Super::AppendString(
-                        strRef,
-                        pattern,
-                        Result,
-                        length,
-                        pattern.Precision,
-                        true,
-                        CharTraits::GetZero()
-                        );
-                }
-                else
-                {
-                    constexpr size_t defaultAlignedLength = sizeof(void*)*2;
-
-                    Super::AppendString(
-                        strRef,
-                        pattern,
-                        Result,
-                        length,
-                        defaultAlignedLength,
-                        true,
-                        CharTraits::GetZero()
-                        );
-                }
+                const SizeType length = static_cast<SizeType>(
+                    bHex ?
+                        IntegerToHexString(arg, Text, pattern.IsUpper, static_cast<int32_t>(sizeof(void*) * 2)) :
+                        IntegerToDecimalString(arg, Text)
+                    );
+
+                Super::CommitString(
+                    strRef,
+                    Text,
+                    length,
+                    pattern.HasPrecision() && pattern.Precision > length ? pattern.Precision : defaultAlignedLength,
+                    true,
+                    CharTraits::GetZero()
+                    );
 
                 return true;
             }
@@ -771,8 +773,7 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
             }
         };
 
-        // convert small numeric type to big numeric type
-        // and convert them to string
+        // convert numeric types to string with the implementation type
 #define FL_CONVERT_TRANSLATOR(Type, BaseType, baseTranslatorType, ImplType) \
     template < typename TCharType > \
     class TTranslator< TCharType, Type > : \
@@ -791,13 +792,18 @@ namespace Formatting // NOLINT(*-concat-nested-namespaces)
         } \
     }
 
-        FL_CONVERT_TRANSLATOR(int16_t, int16_t, TTranslatorBase, TIntegerTranslatorImpl);
-        FL_CONVERT_TRANSLATOR(int32_t, int32_t, TTranslatorBase, TIntegerTranslatorImpl);
-        FL_CONVERT_TRANSLATOR(long, int64_t, TTranslatorBase, TIntegerTranslatorImpl);
-        FL_CONVERT_TRANSLATOR(uint8_t, uint8_t, TTranslatorBase, TIntegerTranslatorImpl);
-        FL_CONVERT_TRANSLATOR(uint16_t, uint16_t, TTranslatorBase, TIntegerTranslatorImpl);
-        FL_CONVERT_TRANSLATOR(uint32_t, uint32_t, TTranslatorBase, TIntegerTranslatorImpl);
-        FL_CONVERT_TRANSLATOR(unsigned long, uint64_t, TTranslatorBase, TIntegerTranslatorImpl);
+        // integers are specialized on the fundamental types instead of the fixed width typedefs,
+        // because int64_t may be long or long long, depends on the data model.
+        // every type is converted with the kernel of its own width.
+        FL_CONVERT_TRANSLATOR(short, short, TTranslatorBase, TIntegerTranslatorImpl);
+        FL_CONVERT_TRANSLATOR(int, int, TTranslatorBase, TIntegerTranslatorImpl);
+        FL_CONVERT_TRANSLATOR(long, long, TTranslatorBase, TIntegerTranslatorImpl);
+        FL_CONVERT_TRANSLATOR(long long, long long, TTranslatorBase, TIntegerTranslatorImpl);
+        FL_CONVERT_TRANSLATOR(unsigned char, unsigned char, TTranslatorBase, TIntegerTranslatorImpl);
+        FL_CONVERT_TRANSLATOR(unsigned short, unsigned short, TTranslatorBase, TIntegerTranslatorImpl);
+        FL_CONVERT_TRANSLATOR(unsigned int, unsigned int, TTranslatorBase, TIntegerTranslatorImpl);
+        FL_CONVERT_TRANSLATOR(unsigned long, unsigned long, TTranslatorBase, TIntegerTranslatorImpl);
+        FL_CONVERT_TRANSLATOR(unsigned long long, unsigned long long, TTranslatorBase, TIntegerTranslatorImpl);
 
         FL_CONVERT_TRANSLATOR(long double, double, TTranslator, TDoubleTranslatorImpl);
 
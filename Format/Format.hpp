@@ -39,3 +39,7 @@
 #include <Format/Common/CharTraits.hpp>
 
 #include <Format/Details/FormatTo.hpp>
+#include <Format/Details/ScatterFormat.hpp>
+#include <Format/Details/LazyFormat.hpp>
+#include <Format/Details/CompiledLiteralFormat.hpp>
+#include <Format/Details/ConstantFormat.hpp>
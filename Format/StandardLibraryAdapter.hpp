@@ -32,3 +32,5 @@
 #include <Format/Format.hpp>
 #include <Format/Details/StandardLibrary/StandardLibraryPolicy.hpp>
 #include <Format/Details/StandardLibrary/FormatTo.hpp>
+#include <Format/Details/StandardLibrary/CompiledFormat.hpp>
+#include <Format/Details/StandardLibrary/ParallelFormat.hpp>
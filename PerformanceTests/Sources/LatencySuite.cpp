@@ -0,0 +1,344 @@
+// ReSharper disable CppClangTidyPerformanceInefficientVectorOperation
+// ReSharper disable CppLocalVariableMayBeConst
+#include "PatternStorages.hpp"
+
+#if !FL_COMPILER_IS_GREATER_THAN_CXX11
+#error "Need C++ 11"
+#endif
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// steady_clock is monotonic on every platform, rdtsc would need a calibrated and invariant tsc
+using LatencyClock = std::chrono::steady_clock;
+
+/// <summary>
+/// HDR style log-linear histogram of nanoseconds.
+/// every power of two range is split into sub_bucket_half_count linear buckets,
+/// so a recorded value is at most 1/64 (~1.6%) off, from 1ns up to 2^40ns with a fixed 2.3K buckets.
+/// </summary>
+class latency_histogram
+{
+public:
+    enum
+    {
+        sub_bucket_bits = 7,
+        sub_bucket_count = 1 << sub_bucket_bits,
+        sub_bucket_half_count = sub_bucket_count / 2,
+        max_value_bits = 40,
+        bucket_count = sub_bucket_count + (max_value_bits - sub_bucket_bits + 1) * sub_bucket_half_count
+    };
+
+    latency_histogram() :
+        counts(bucket_count, 0),
+        total_count(0),
+        total_value(0),
+        max_value(0)
+    {
+    }
+
+    void record(uint64_t value)
+    {
+        const uint64_t limit = (static_cast<uint64_t>(1) << max_value_bits) - 1;
+
+        if (value > limit)
+        {
+            value = limit;
+        }
+
+        ++counts[get_index(value)];
+        ++total_count;
+        total_value += value;
+
+        if (value > max_value)
+        {
+            max_value = value;
+        }
+    }
+
+    uint64_t get_count() const
+    {
+        return total_count;
+    }
+
+    uint64_t get_max() const
+    {
+        return max_value;
+    }
+
+    double get_mean() const
+    {
+        return total_count > 0 ? static_cast<double>(total_value) / total_count : 0;
+    }
+
+    /// <summary>
+    /// the highest value equivalent to the bucket that holds the percentile, like HdrHistogram reports it
+    /// </summary>
+    uint64_t get_value_at_percentile(double percentile) const
+    {
+        if (total_count == 0)
+        {
+            return 0;
+        }
+
+        uint64_t target = static_cast<uint64_t>(percentile / 100.0 * total_count + 0.5);
+
+        if (target < 1)
+        {
+            target = 1;
+        }
+
+        uint64_t cumulative = 0;
+
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            cumulative += counts[i];
+
+            if (cumulative >= target)
+            {
+                const uint64_t highest = get_highest_value(i);
+                return highest < max_value ? highest : max_value;
+            }
+        }
+
+        return max_value;
+    }
+
+private:
+    static size_t get_index(uint64_t value)
+    {
+        if (value < sub_bucket_count)
+        {
+            return static_cast<size_t>(value);
+        }
+
+        int most_significant_bit = 0;
+
+        for (uint64_t v = value; v > 1; v >>= 1)
+        {
+            ++most_significant_bit;
+        }
+
+        // value >> shift is in [sub_bucket_half_count, sub_bucket_count)
+        const int shift = most_significant_bit - (sub_bucket_bits - 1);
+
+        return sub_bucket_count + (shift - 1) * sub_bucket_half_count + static_cast<size_t>((value >> shift) - sub_bucket_half_count);
+    }
+
+    static uint64_t get_highest_value(size_t index)
+    {
+        if (index < sub_bucket_count)
+        {
+            return index;
+        }
+
+        const size_t offset = index - sub_bucket_count;
+        const int shift = static_cast<int>(offset / sub_bucket_half_count) + 1;
+        const uint64_t sub_bucket = offset % sub_bucket_half_count + sub_bucket_half_count;
+
+        return ((sub_bucket + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts;
+    uint64_t total_count;
+    uint64_t total_value;
+    uint64_t max_value;
+};
+
+template <typename TFunction>
+static void record_call(latency_histogram& histogram, TFunction&& function)
+{
+    auto start = LatencyClock::now();
+    function();
+    auto end = LatencyClock::now();
+
+    histogram.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+}
+
+static void print_row(const char* scenario, const char* run, const latency_histogram& histogram)
+{
+    std::cout << "| " << std::left << std::setw(20) << scenario << " | " << std::setw(4) << run << " | "
+        << std::right << std::setw(8) << histogram.get_count() << " | "
+        << std::setw(8) << static_cast<uint64_t>(histogram.get_mean()) << " | "
+        << std::setw(8) << histogram.get_value_at_percentile(50) << " | "
+        << std::setw(8) << histogram.get_value_at_percentile(99) << " | "
+        << std::setw(8) << histogram.get_value_at_percentile(99.9) << " | "
+        << std::setw(10) << histogram.get_max() << " |\n";
+}
+
+static std::vector<std::string> make_cold_formats(const char* scenario, const char* body, int count)
+{
+    std::vector<std::string> formats;
+    formats.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        formats.push_back(StandardLibrary::Format("{0} #{1}.{2}", body, scenario, i));
+    }
+
+    return formats;
+}
+
+/// <summary>
+/// times one scenario on a fresh thread, so the thread local pattern cache starts empty.
+/// cold: every call uses a format the cache has never seen (first-call parse and cache insert).
+/// warm: the same format over and over after a warm up.
+/// </summary>
+template <typename TFunction>
+static void run_scenario(const char* scenario, const char* format, int cold_samples, int warm_samples, TFunction function)
+{
+    const std::vector<std::string> cold_formats = make_cold_formats(scenario, format, cold_samples);
+    const std::string warm_format = format;
+
+    latency_histogram cold;
+    latency_histogram warm;
+
+    std::thread worker([&]()
+        {
+            std::string sink;
+
+            for (int i = 0; i < cold_samples; ++i)
+            {
+                record_call(cold, [&]() { function(sink, cold_formats[i], i); });
+            }
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                function(sink, warm_format, i);
+            }
+
+            for (int i = 0; i < warm_samples; ++i)
+            {
+                record_call(warm, [&]() { function(sink, warm_format, i); });
+            }
+        });
+
+    worker.join();
+
+    print_row(scenario, "cold", cold);
+    print_row(scenario, "warm", warm);
+}
+
+/// <summary>
+/// readers time warm lookups in the SharedMutex guarded cache while a writer keeps inserting new formats,
+/// every insert takes the locker exclusively and the readers behind it stall.
+/// </summary>
+static void run_writer_stall_scenario(int cold_samples, int warm_samples)
+{
+    const char* format = "{0} reader {1} {2}";
+    const std::vector<std::string> cold_formats = make_cold_formats("rwlock", format, cold_samples);
+    const std::string warm_format = format;
+
+    latency_histogram cold;
+    latency_histogram warm;
+    std::atomic<bool> stopped(false);
+
+    std::thread writer([&]()
+        {
+            TAutoString<char> sink;
+
+            for (int i = 0; !stopped.load(std::memory_order_relaxed); ++i)
+            {
+                const std::string writer_format = StandardLibrary::Format("{{0}} writer {0}", i);
+
+                sink.Clear();
+                Details::FormatTo<char, shared_mutex_pattern_storage>(sink, writer_format, i);
+            }
+        });
+
+    std::thread reader([&]()
+        {
+            TAutoString<char> sink;
+
+            for (int i = 0; i < cold_samples; ++i)
+            {
+                record_call(cold, [&]()
+                    {
+                        sink.Clear();
+                        Details::FormatTo<char, shared_mutex_pattern_storage>(sink, cold_formats[i], i, "text", i * 0.5);
+                    });
+            }
+
+            for (int i = 0; i < warm_samples; ++i)
+            {
+                record_call(warm, [&]()
+                    {
+                        sink.Clear();
+                        Details::FormatTo<char, shared_mutex_pattern_storage>(sink, warm_format, i, "text", i * 0.5);
+                    });
+            }
+        });
+
+    reader.join();
+    stopped.store(true, std::memory_order_relaxed);
+    writer.join();
+
+    print_row("rwlock_writer_stall", "cold", cold);
+    print_row("rwlock_writer_stall", "warm", warm);
+}
+
+/// <summary>
+/// Runs the tail latency suite, every scenario reports cold and warm percentiles in nanoseconds.
+/// options: --samples N (warm samples per scenario), --cold-samples N
+/// </summary>
+int run_latency_suite(int argc, char* argv[])
+{
+#if FL_DEBUG
+    int warm_samples = 100000;
+#else
+    int warm_samples = 1000000;
+#endif
+
+    int cold_samples = 10000;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+        {
+            warm_samples = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--cold-samples") == 0 && i + 1 < argc)
+        {
+            cold_samples = std::atoi(argv[++i]);
+        }
+    }
+
+    const std::string long_text(300, 'x');
+
+    std::cout << "C++ Version:" << FL_CXX_STANDARD << "\n";
+    std::cout << "Latency (ns):\n";
+    std::cout << "| Scenario             | Run  | Samples  | Mean     | p50      | p99      | p99.9    | Max        |\n";
+    std::cout << "|----------------------|------|----------|----------|----------|----------|----------|------------|\n";
+
+    // the cost of the clock itself, subtract it mentally from the rows below
+    run_scenario("clock_overhead", "{0}", cold_samples, warm_samples, [](std::string&, const std::string&, int) {});
+
+    run_scenario("short_output", "{0} {1} {2}", cold_samples, warm_samples, [](std::string& sink, const std::string& format, int i)
+        {
+            StandardLibrary::FormatTo(sink, format, i, "text", i * 0.5);
+        });
+
+    // more than the inline buffer of TAutoString, the result is built on the heap
+    run_scenario("heap_spill", "{0} {1}", cold_samples, warm_samples, [&long_text](std::string& sink, const std::string& format, int i)
+        {
+            StandardLibrary::FormatTo(sink, format, i, long_text);
+        });
+
+    // doubles above INT32_MAX are converted by sprintf
+    run_scenario("large_double", "{0} {1:e3}", cold_samples, warm_samples, [](std::string& sink, const std::string& format, int i)
+        {
+            StandardLibrary::FormatTo(sink, format, 1e12 + i, 1e15 + i);
+        });
+
+    run_writer_stall_scenario(cold_samples, warm_samples);
+
+    return 0;
+}
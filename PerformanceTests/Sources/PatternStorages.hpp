@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Format/StandardLibraryAdapter.hpp>
+
+using namespace Formatting;
+
+// the cache of every thread is private, this is what StandardLibrary uses by default
+typedef Details::TGlobalPatternStorage<Details::StandardLibrary::TStandardPolicy<char, Details::SharedMutexNone>> thread_local_pattern_storage;
+
+// one process wide cache guarded by SharedMutex, every thread contends on the same locker
+class shared_mutex_pattern_storage :
+    public Details::TPatternStorage<Details::StandardLibrary::TStandardPolicy<char, Details::SharedMutex>>
+{
+public:
+    static shared_mutex_pattern_storage* GetStorage()
+    {
+        static shared_mutex_pattern_storage StaticStorage;
+        return &StaticStorage;
+    }
+};
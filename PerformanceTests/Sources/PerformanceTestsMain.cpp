@@ -14,6 +14,7 @@
 #include <vector>
 #include <string>
 #include <iomanip>
+#include <cstring>
 
 using namespace Formatting;
 using Clock = std::chrono::high_resolution_clock;
@@ -22,6 +23,12 @@ using Clock = std::chrono::high_resolution_clock;
 #define TEST_FORMAT_TO_MACROS
 //#define TEST_E_FORMAT
 
+// ScalingMatrix.cpp
+int run_scaling_matrix(int argc, char* argv[]);
+
+// LatencySuite.cpp
+int run_latency_suite(int argc, char* argv[]);
+
 void test_formatting_standard_library(int iterations)
 {
     std::string str;
@@ -190,8 +197,23 @@ void run_multi_thread_tests(int iterations, int thread_count)
 #endif
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+    // --matrix prints the multi-thread scaling matrix as csv (or json with --json) instead of the tables
+    // --latency prints the cold/warm percentiles of single calls
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--matrix") == 0)
+        {
+            return run_scaling_matrix(argc, argv);
+        }
+
+        if (std::strcmp(argv[i], "--latency") == 0)
+        {
+            return run_latency_suite(argc, argv);
+        }
+    }
+
     std::cout << "C++ Version:" << FL_CXX_STANDARD << std::endl;  // NOLINT(performance-avoid-endl)
 
 #if FL_DEBUG
@@ -0,0 +1,355 @@
+// ReSharper disable CppClangTidyPerformanceInefficientVectorOperation
+// ReSharper disable CppLocalVariableMayBeConst
+#include "PatternStorages.hpp"
+
+#if !FL_COMPILER_IS_GREATER_THAN_CXX11
+#error "Need C++ 11"
+#endif
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+
+using Clock = std::chrono::high_resolution_clock;
+
+enum class storage_mode
+{
+    thread_local_cache,
+    shared_mutex_cache,
+    uncached
+};
+
+static const char* get_storage_mode_name(storage_mode mode)
+{
+    switch (mode)
+    {
+    case storage_mode::thread_local_cache:
+        return "thread_local";
+    case storage_mode::shared_mutex_cache:
+        return "shared_mutex";
+    case storage_mode::uncached:
+        return "uncached";
+    }
+
+    return "unknown";
+}
+
+struct matrix_config
+{
+    storage_mode mode;
+    int thread_count;
+    int hot_set_size;
+    double miss_ratio;
+    int operations_per_thread;
+    int config_index;
+};
+
+struct matrix_result
+{
+    matrix_config config;
+    double seconds;
+    double ops_per_second;
+    double ops_per_second_per_thread;
+    double efficiency;
+};
+
+static std::string make_hot_format(int index)
+{
+    return StandardLibrary::Format("{{0}} record {{1}} value {{2}} #{0}", index);
+}
+
+static std::string make_miss_format(int config_index, int thread_index, int index)
+{
+    return StandardLibrary::Format("{{0}} miss {{1}} value {{2}} #{0}.{1}.{2}", config_index, thread_index, index);
+}
+
+template <typename TPatternStorageType>
+static void format_record(TAutoString<char>& sink, const std::string& format, int value)
+{
+    sink.Clear();
+    Details::FormatTo<char, TPatternStorageType>(sink, format, value, "payload", value * 0.5);
+}
+
+static void format_record(storage_mode mode, TAutoString<char>& sink, const std::string& format, int value)
+{
+    switch (mode)
+    {
+    case storage_mode::thread_local_cache:
+        format_record<thread_local_pattern_storage>(sink, format, value);
+        break;
+    case storage_mode::shared_mutex_cache:
+        format_record<shared_mutex_pattern_storage>(sink, format, value);
+        break;
+    case storage_mode::uncached:
+        sink.Clear();
+        Details::FormatOnceTo(sink, format.c_str(), format.size(), value, "payload", value * 0.5);
+        break;
+    }
+}
+
+static double run_config(const matrix_config& config, const std::vector<std::string>& hot_formats)
+{
+    // a miss is a format the cache has never seen, they are created up front so the timing only covers formatting
+    const int miss_period = config.miss_ratio > 0 ? static_cast<int>(1.0 / config.miss_ratio + 0.5) : 0;
+
+    std::vector<std::vector<std::string>> miss_formats(config.thread_count);
+
+    if (miss_period > 0)
+    {
+        for (int t = 0; t < config.thread_count; ++t)
+        {
+            miss_formats[t].reserve(config.operations_per_thread / miss_period + 1);
+
+            for (int i = 0; i < config.operations_per_thread; i += miss_period)
+            {
+                miss_formats[t].push_back(make_miss_format(config.config_index, t, i));
+            }
+        }
+    }
+
+    std::atomic<int> ready_count(0);
+    std::atomic<bool> started(false);
+    std::vector<std::thread> threads;
+
+    // every worker stamps the end of its loop, the thread_local cache destructors run after it and are not timed
+    std::vector<Clock::time_point> end_times(config.thread_count);
+
+    for (int t = 0; t < config.thread_count; ++t)
+    {
+        threads.emplace_back([&, t]()
+            {
+                TAutoString<char> sink;
+
+                // warm up, every hot format is in the cache before the clock starts
+                for (int i = 0; i < config.hot_set_size; ++i)
+                {
+                    format_record(config.mode, sink, hot_formats[i], i);
+                }
+
+                ready_count.fetch_add(1);
+
+                while (!started.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+
+                size_t miss_index = 0;
+
+                for (int i = 0; i < config.operations_per_thread; ++i)
+                {
+                    if (miss_period > 0 && i % miss_period == 0)
+                    {
+                        format_record(config.mode, sink, miss_formats[t][miss_index++], i);
+                    }
+                    else
+                    {
+                        // a stride that is coprime with the hot set sizes, so the accesses are spread over the whole set
+                        format_record(config.mode, sink, hot_formats[static_cast<size_t>(i + t) * 7919 % config.hot_set_size], i);
+                    }
+                }
+
+                end_times[t] = Clock::now();
+            });
+    }
+
+    while (ready_count.load() != config.thread_count)
+    {
+        std::this_thread::yield();
+    }
+
+    auto start = Clock::now();
+    started.store(true, std::memory_order_release);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto end = start;
+
+    for (const auto& end_time : end_times)
+    {
+        if (end_time > end)
+        {
+            end = end_time;
+        }
+    }
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+static std::vector<int> get_thread_counts(int max_thread_count)
+{
+    std::vector<int> counts;
+
+    for (int count = 1; count < max_thread_count; count *= 2)
+    {
+        counts.push_back(count);
+    }
+
+    counts.push_back(max_thread_count);
+
+    return counts;
+}
+
+static void print_csv(const std::vector<matrix_result>& results)
+{
+    std::cout << "mode,threads,hot_set,miss_ratio,ops,seconds,ops_per_sec,ops_per_sec_per_thread,efficiency\n";
+
+    for (const auto& result : results)
+    {
+        std::cout << get_storage_mode_name(result.config.mode) << ","
+            << result.config.thread_count << ","
+            << result.config.hot_set_size << ","
+            << std::setprecision(2) << result.config.miss_ratio << ","
+            << static_cast<long long>(result.config.operations_per_thread) * result.config.thread_count << ","
+            << std::setprecision(6) << result.seconds << ","
+            << std::setprecision(0) << result.ops_per_second << ","
+            << result.ops_per_second_per_thread << ","
+            << std::setprecision(3) << result.efficiency << "\n";
+    }
+}
+
+static void print_json(const std::vector<matrix_result>& results)
+{
+    std::cout << "[\n";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+
+        std::cout << "  {\"mode\": \"" << get_storage_mode_name(result.config.mode) << "\""
+            << ", \"threads\": " << result.config.thread_count
+            << ", \"hot_set\": " << result.config.hot_set_size
+            << ", \"miss_ratio\": " << std::setprecision(2) << result.config.miss_ratio
+            << ", \"ops\": " << static_cast<long long>(result.config.operations_per_thread) * result.config.thread_count
+            << ", \"seconds\": " << std::setprecision(6) << result.seconds
+            << ", \"ops_per_sec\": " << std::setprecision(0) << result.ops_per_second
+            << ", \"ops_per_sec_per_thread\": " << result.ops_per_second_per_thread
+            << ", \"efficiency\": " << std::setprecision(3) << result.efficiency
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    std::cout << "]\n";
+}
+
+/// <summary>
+/// Runs the scaling matrix: storage modes x thread counts x hot set sizes x cache miss ratios.
+/// efficiency is the per thread throughput relative to the single thread run of the same configuration,
+/// 1.0 means linear scaling.
+/// options: --json, --ops N (per thread), --threads N (max thread count)
+/// </summary>
+int run_scaling_matrix(int argc, char* argv[])
+{
+    bool json = false;
+
+#if FL_DEBUG
+    int operations_per_thread = 20000;
+#else
+    int operations_per_thread = 200000;
+#endif
+
+    int max_thread_count = static_cast<int>(std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--json") == 0)
+        {
+            json = true;
+        }
+        else if (std::strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+        {
+            operations_per_thread = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            max_thread_count = std::atoi(argv[++i]);
+        }
+    }
+
+    if (max_thread_count < 1)
+    {
+        max_thread_count = 1;
+    }
+
+    if (operations_per_thread < 1)
+    {
+        operations_per_thread = 1;
+    }
+
+    const storage_mode modes[] = { storage_mode::thread_local_cache, storage_mode::shared_mutex_cache, storage_mode::uncached };
+    const int hot_set_sizes[] = { 10, 1000, 100000 };
+    const double miss_ratios[] = { 0.0, 0.01, 0.1 };
+    const std::vector<int> thread_counts = get_thread_counts(max_thread_count);
+
+    std::vector<std::string> hot_formats;
+    hot_formats.reserve(hot_set_sizes[FL_ARRAY_COUNTOF(hot_set_sizes) - 1]);
+
+    for (int i = 0; i < hot_set_sizes[FL_ARRAY_COUNTOF(hot_set_sizes) - 1]; ++i)
+    {
+        hot_formats.push_back(make_hot_format(i));
+    }
+
+    std::vector<matrix_result> results;
+    int config_index = 0;
+
+    for (auto mode : modes)
+    {
+        for (auto hot_set_size : hot_set_sizes)
+        {
+            for (auto miss_ratio : miss_ratios)
+            {
+                // there is no cache to miss
+                if (mode == storage_mode::uncached && miss_ratio > 0)
+                {
+                    continue;
+                }
+
+                double single_thread_ops_per_second = 0;
+
+                for (auto thread_count : thread_counts)
+                {
+                    matrix_result result;
+                    result.config.mode = mode;
+                    result.config.thread_count = thread_count;
+                    result.config.hot_set_size = hot_set_size;
+                    result.config.miss_ratio = miss_ratio;
+                    result.config.operations_per_thread = operations_per_thread;
+                    result.config.config_index = config_index++;
+
+                    result.seconds = run_config(result.config, hot_formats);
+                    result.ops_per_second = static_cast<double>(operations_per_thread) * thread_count / result.seconds;
+                    result.ops_per_second_per_thread = result.ops_per_second / thread_count;
+
+                    if (thread_count == 1)
+                    {
+                        single_thread_ops_per_second = result.ops_per_second;
+                    }
+
+                    result.efficiency = single_thread_ops_per_second > 0 ? result.ops_per_second_per_thread / single_thread_ops_per_second : 0;
+
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    std::cout << std::fixed;
+
+    if (json)
+    {
+        print_json(results);
+    }
+    else
+    {
+        print_csv(results);
+    }
+
+    return 0;
+}
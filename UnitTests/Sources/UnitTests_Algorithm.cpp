@@ -12,6 +12,7 @@
 
 #include <Format/Common/Algorithm.hpp>
 #include <Format/Details/StringConvertAlgorithm.hpp>
+#include <Format/Details/PatternParser.hpp>
 
 using namespace Formatting;
 
@@ -107,6 +108,139 @@ TEST(Algorithm, TestUInt64ToStringW)
     EXPECT_STREQ(MovedText, L"1234567890123456789");
 }
 
+TEST(Algorithm, TestCountDecimalDigits)
+{
+    EXPECT_EQ(Details::CountDecimalDigits(0U), 1);
+    EXPECT_EQ(Details::CountDecimalDigits(9U), 1);
+    EXPECT_EQ(Details::CountDecimalDigits(10U), 2);
+    EXPECT_EQ(Details::CountDecimalDigits(99999U), 5);
+    EXPECT_EQ(Details::CountDecimalDigits(100000U), 6);
+    EXPECT_EQ(Details::CountDecimalDigits(4294967295U), 10);
+    EXPECT_EQ(Details::CountDecimalDigits(static_cast<uint64_t>(4294967296ULL)), 10);
+    EXPECT_EQ(Details::CountDecimalDigits(static_cast<uint64_t>(10000000000ULL)), 11);
+    EXPECT_EQ(Details::CountDecimalDigits(static_cast<uint64_t>(18446744073709551615ULL)), 20);
+}
+
+TEST(Algorithm, TestIntegerToDecimalString)
+{
+    char buffer[24];
+
+    buffer[Details::IntegerToDecimalString(0, buffer)] = 0;
+    EXPECT_STREQ(buffer, "0");
+
+    buffer[Details::IntegerToDecimalString(static_cast<int16_t>(-32768), buffer)] = 0;
+    EXPECT_STREQ(buffer, "-32768");
+
+    buffer[Details::IntegerToDecimalString(static_cast<uint16_t>(65535), buffer)] = 0;
+    EXPECT_STREQ(buffer, "65535");
+
+    buffer[Details::IntegerToDecimalString(static_cast<int32_t>(-2147483647 - 1), buffer)] = 0;
+    EXPECT_STREQ(buffer, "-2147483648");
+
+    buffer[Details::IntegerToDecimalString(static_cast<int64_t>(-9223372036854775807LL - 1), buffer)] = 0;
+    EXPECT_STREQ(buffer, "-9223372036854775808");
+
+    buffer[Details::IntegerToDecimalString(static_cast<uint64_t>(18446744073709551615ULL), buffer)] = 0;
+    EXPECT_STREQ(buffer, "18446744073709551615");
+
+    wchar_t bufferW[24];
+    bufferW[Details::IntegerToDecimalString(-1234567890123456789LL, bufferW)] = 0;
+    EXPECT_STREQ(bufferW, L"-1234567890123456789");
+}
+
+TEST(Algorithm, TestIntegerToHexString)
+{
+    char buffer[24];
+
+    buffer[Details::IntegerToHexString(0, buffer, false)] = 0;
+    EXPECT_STREQ(buffer, "0");
+
+    buffer[Details::IntegerToHexString(0xABC, buffer, false)] = 0;
+    EXPECT_STREQ(buffer, "abc");
+
+    buffer[Details::IntegerToHexString(0xABC, buffer, true, 8)] = 0;
+    EXPECT_STREQ(buffer, "00000ABC");
+
+    buffer[Details::IntegerToHexString(-0x7b, buffer, false, 4)] = 0;
+    EXPECT_STREQ(buffer, "-007b");
+
+    buffer[Details::IntegerToHexString(static_cast<uint8_t>(0xFF), buffer, true, 8)] = 0;
+    EXPECT_STREQ(buffer, "FF");
+
+    buffer[Details::IntegerToHexString(static_cast<uint64_t>(0x0123456789ABCDEFULL), buffer, false, 16)] = 0;
+    EXPECT_STREQ(buffer, "0123456789abcdef");
+
+    buffer[Details::IntegerToHexString(static_cast<uint64_t>(0xFEDCBA9876543210ULL), buffer, true)] = 0;
+    EXPECT_STREQ(buffer, "FEDCBA9876543210");
+
+    // compare with the C library, every digits count of 64bit values
+    uint64_t value = 1;
+    for (int i = 0; i < 64; ++i, value = (value << 1) | (i & 1))
+    {
+        char expected[24];
+        snprintf(expected, sizeof(expected), "%llx", static_cast<unsigned long long>(value));
+
+        buffer[Details::IntegerToHexString(value, buffer, false)] = 0;
+        EXPECT_STREQ(buffer, expected);
+
+        snprintf(expected, sizeof(expected), "%016llX", static_cast<unsigned long long>(value));
+
+        buffer[Details::IntegerToHexString(value, buffer, true, 16)] = 0;
+        EXPECT_STREQ(buffer, expected);
+    }
+
+    wchar_t bufferW[24];
+    bufferW[Details::IntegerToHexString(static_cast<uint64_t>(0x0123456789ABCDEFULL), bufferW, true, 16)] = 0;
+    EXPECT_STREQ(bufferW, L"0123456789ABCDEF");
+}
+
+TEST(Algorithm, TestIntegerToBinaryStringLimits)
+{
+    char buffer[65];
+
+    EXPECT_EQ((Details::IntegerToBinaryString<char, int>(0, buffer)), 1);
+    EXPECT_STREQ(buffer + 31, "0");
+
+    EXPECT_EQ((Details::IntegerToBinaryString<char, uint8_t>(0x80, buffer)), 8);
+    EXPECT_STREQ(buffer, "10000000");
+
+    EXPECT_EQ((Details::IntegerToBinaryString<char, int16_t>(-1, buffer)), 16);
+    EXPECT_STREQ(buffer, "1111111111111111");
+
+    EXPECT_EQ((Details::IntegerToBinaryString<char, uint64_t>(0x8000000000000001ULL, buffer)), 64);
+    EXPECT_STREQ(buffer, "1000000000000000000000000000000000000000000000000000000000000001");
+}
+
+template <typename TCharType>
+static void TestFindCurlyBraceAt()
+{
+    TCharType Text[64];
+
+    for (size_t Position = 0; Position < FL_ARRAY_COUNTOF(Text); ++Position)
+    {
+        for (size_t i = 0; i < FL_ARRAY_COUNTOF(Text); ++i)
+        {
+            Text[i] = static_cast<TCharType>('a' + i % 26);
+        }
+
+        Text[Position] = static_cast<TCharType>(Position % 2 == 0 ? '{' : '}');
+
+        EXPECT_EQ(Details::FindCurlyBrace(Text, Text + FL_ARRAY_COUNTOF(Text)), Text + Position);
+
+        // not found before the end
+        EXPECT_EQ(Details::FindCurlyBrace(Text, Text + Position), Text + Position);
+    }
+}
+
+TEST(Algorithm, TestFindCurlyBrace)
+{
+    TestFindCurlyBraceAt<char>();
+    TestFindCurlyBraceAt<wchar_t>();
+
+    const char* const Empty = "";
+    EXPECT_EQ(Details::FindCurlyBrace(Empty, Empty), Empty);
+}
+
 TEST(Algorithm, TestDoubleToString)
 {
     char buffer[32];
@@ -173,6 +307,55 @@ TEST(TCharTraits, StringPrintf)
     EXPECT_EQ(std::wcscmp(wbuffer, L"test 123"), 0);
 }
 
+template <typename TCharType>
+static void TestFillAndCopy()
+{
+    // cover the short path, full vector stores and the overlapped tail
+    const size_t Lengths[] = { 0, 1, 7, 16, 17, 31, 32, 33, 100 };
+
+    for (size_t i = 0; i < FL_ARRAY_COUNTOF(Lengths); ++i)
+    {
+        const size_t Length = Lengths[i];
+
+        TCharType Buffer[128];
+        TCharType Source[128];
+
+        for (size_t j = 0; j < FL_ARRAY_COUNTOF(Buffer); ++j)
+        {
+            Buffer[j] = static_cast<TCharType>('#');
+            Source[j] = static_cast<TCharType>('a' + j % 26);
+        }
+
+        TCharTraits<TCharType>::Fill(Buffer + 1, static_cast<TCharType>('x'), Length);
+
+        EXPECT_EQ(Buffer[0], static_cast<TCharType>('#'));
+        for (size_t j = 0; j < Length; ++j)
+        {
+            EXPECT_EQ(Buffer[j + 1], static_cast<TCharType>('x'));
+        }
+        EXPECT_EQ(Buffer[Length + 1], static_cast<TCharType>('#'));
+
+        TCharTraits<TCharType>::Copy(Buffer + 1, Source, Length);
+
+        for (size_t j = 0; j < Length; ++j)
+        {
+            EXPECT_EQ(Buffer[j + 1], Source[j]);
+        }
+        EXPECT_EQ(Buffer[Length + 1], static_cast<TCharType>('#'));
+    }
+}
+
+TEST(TCharTraits, FillAndCopy)
+{
+    TestFillAndCopy<char>();
+    TestFillAndCopy<wchar_t>();
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+    TestFillAndCopy<char16_t>();
+    TestFillAndCopy<char32_t>();
+#endif
+}
+
 TEST(TCharTraits, CompareN)
 {
     EXPECT_EQ(TCharTraits<char>::CompareN("hello111", "hello222", 5), 0);
@@ -10,6 +10,14 @@
 #endif
 
 #include <Format/Common/AutoString.hpp>
+#include <Format/Common/ThreadStorageManager.hpp>
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#endif
 
 using namespace Formatting;
 
@@ -313,6 +321,30 @@ TEST(TAutoString, AddAlignWStr)
     EXPECT_STREQ(str.CStr(), L"Hello     $$$$$WorldHi000HelloWorld12345");
 }
 
+TEST(TAutoString, ReserveCommit)
+{
+    TAutoString<char> str;
+    str.AddStr("Hello");
+
+    char* Text = str.Reserve(16);
+    memcpy(Text, ", World", 7);
+    str.Commit(7);
+    EXPECT_STREQ(str.CStr(), "Hello, World");
+
+    // the reserved space is moved to heap together with the content
+    const std::string longStr(FL_DEFAULT_AUTO_STRING_STACK_LENGTH * 3, 'A');
+    Text = str.Reserve(longStr.length());
+    memcpy(Text, longStr.c_str(), longStr.length());
+    str.Commit(longStr.length());
+    EXPECT_FALSE(str.IsDataOnStack());
+    EXPECT_STREQ(str.CStr(), ("Hello, World" + longStr).c_str());
+
+    str.Reserve(1024);
+    str.Commit(0);
+    EXPECT_EQ(str.GetLength(), 12 + longStr.length());
+    EXPECT_STREQ(str.CStr(), ("Hello, World" + longStr).c_str());
+}
+
 TEST(TAutoString, Clear)
 {
     TAutoString<wchar_t> str;
@@ -368,4 +400,64 @@ TEST(TAutoString, RangeBasedFor)
     }
     EXPECT_EQ(index, strlen(expected));
 }
-#endif
\ No newline at end of file
+#endif
+
+#if FL_WITH_THREAD_LOCAL && FL_WITH_THREAD_EXIT_CALLBACK && FL_COMPILER_IS_GREATER_THAN_CXX11
+struct ThreadStorageManagerTestStorage
+{
+    int Value = 0;
+};
+
+TEST(TThreadStorageManager, RecycleStorageOfExitedThreads)
+{
+    typedef Details::TThreadStorageManager<ThreadStorageManagerTestStorage> ManagerType;
+
+    std::vector<ThreadStorageManagerTestStorage*> Storages(32, nullptr);
+
+    // one short-lived thread after another, each one takes the storage released by the previous one
+    for (size_t i = 0; i < Storages.size(); ++i)
+    {
+        std::thread Worker([&Storages, i]()
+            {
+                Storages[i] = ManagerType::GetStorage();
+                ++Storages[i]->Value;
+            });
+
+        Worker.join();
+    }
+
+    for (size_t i = 0; i < Storages.size(); ++i)
+    {
+        EXPECT_EQ(Storages[i], Storages[0]);
+    }
+
+    EXPECT_EQ(ManagerType::GetStorageCount(), 1u);
+    EXPECT_EQ(Storages[0]->Value, 32);
+
+    // live threads never share a storage
+    ThreadStorageManagerTestStorage* First = nullptr;
+    ThreadStorageManagerTestStorage* Second = nullptr;
+
+    std::atomic<int> AcquiredCount(0);
+
+    auto AcquireAndWait = [&AcquiredCount](ThreadStorageManagerTestStorage*& storage)
+        {
+            storage = ManagerType::GetStorage();
+            ++AcquiredCount;
+
+            while (AcquiredCount.load() < 2)
+            {
+                std::this_thread::yield();
+            }
+        };
+
+    std::thread FirstWorker(AcquireAndWait, std::ref(First));
+    std::thread SecondWorker(AcquireAndWait, std::ref(Second));
+
+    FirstWorker.join();
+    SecondWorker.join();
+
+    EXPECT_NE(First, Second);
+    EXPECT_EQ(ManagerType::GetStorageCount(), 2u);
+}
+#endif
@@ -15,6 +15,8 @@
 #endif
 
 #include <iomanip>
+#include <thread>
+#include <sstream>
 #include <Format/StandardLibraryAdapter.hpp>
 
 using namespace Formatting;
@@ -231,7 +233,8 @@ TEST(Format, STL_WChar_FormatTo_FL_STD_FORMAT_TO)
 }
 #endif
 
-#if FL_COMPILER_IS_GREATER_THAN_CXX11
+// u8 literals are char8_t since C++20, they can not be formatted into a std::string any more
+#if FL_COMPILER_IS_GREATER_THAN_CXX11 && !defined(__cpp_char8_t)
 TEST(Format, TestUTF_8)
 {
     const std::string str = StandardLibrary::Format(
@@ -507,6 +510,765 @@ TEST(Format, TestLongTypes)
     EXPECT_EQ(resultW, L"499602d2 7048860ddf79 462d53c8abac0");
 }
 
+TEST(Format, TestIntegerLimits)
+{
+    EXPECT_EQ(StandardLibrary::Format("{0} {1}", static_cast<short>(-32768), static_cast<unsigned short>(65535)), "-32768 65535");
+    EXPECT_EQ(StandardLibrary::Format("{0} {1}", static_cast<int>(-2147483647 - 1), 4294967295U), "-2147483648 4294967295");
+    EXPECT_EQ(StandardLibrary::Format("{0} {1}", -9223372036854775807LL - 1, 18446744073709551615ULL), "-9223372036854775808 18446744073709551615");
+    EXPECT_EQ(StandardLibrary::Format("{0} {1}", static_cast<unsigned char>(255), static_cast<unsigned char>(0)), "255 0");
+    EXPECT_EQ(StandardLibrary::Format(L"{0} {1}", static_cast<int64_t>(-9223372036854775807LL - 1), static_cast<uint64_t>(18446744073709551615ULL)), L"-9223372036854775808 18446744073709551615");
+}
+
+TEST(Format, TestNegativeDecimalPrecision)
+{
+    EXPECT_EQ(StandardLibrary::Format("{0:d5}", -123), "-00123");
+    EXPECT_EQ(StandardLibrary::Format("{0:d5}", 123), "00123");
+    EXPECT_EQ(StandardLibrary::Format("{0:d2}", -123), "-123");
+    EXPECT_EQ(StandardLibrary::Format("{0:d4}", -123), "-0123");
+    EXPECT_EQ(StandardLibrary::Format("{0:d3}", -123), "-123");
+    EXPECT_EQ(StandardLibrary::Format(L"{0:D4}", -7LL), L"-0007");
+}
+
+TEST(Format, TestHexPrecision)
+{
+    EXPECT_EQ(StandardLibrary::Format("{0:x16}", static_cast<uint64_t>(0xDEADBEEFULL)), "00000000deadbeef");
+    EXPECT_EQ(StandardLibrary::Format("{0:X16}", static_cast<uint64_t>(0x0123456789ABCDEFULL)), "0123456789ABCDEF");
+    EXPECT_EQ(StandardLibrary::Format("{0:x12}", 0x7b), "00000000007b");
+    EXPECT_EQ(StandardLibrary::Format("{0:x4}", -0x7b), "-007b");
+    EXPECT_EQ(StandardLibrary::Format("{0:x3}", -0x7b), "-07b");
+    EXPECT_EQ(StandardLibrary::Format("{0,10:x4}", 0x7b), "      007b");
+    EXPECT_EQ(StandardLibrary::Format("{0:b8}", static_cast<uint8_t>(5)), "00000101");
+    EXPECT_EQ(StandardLibrary::Format(L"{0:x16}", static_cast<uint64_t>(0xDEADBEEFULL)), L"00000000deadbeef");
+}
+
+TEST(Format, TestNumberAlignmentInPlace)
+{
+    EXPECT_EQ(StandardLibrary::Format("[{0,8}][{0,-8}][{1,6:d4}][{2,12:b}]", -42, 7, 5), "[     -42][-42     ][  0007][         101]");
+    EXPECT_EQ(StandardLibrary::Format("[{0,-6:X}][{1:d6}][{2,3}]", 255, -7, 123456), "[FF    ][-000007][123456]");
+    EXPECT_EQ(StandardLibrary::Format("[{0,-7:d4}][{1,8:d4}][{2,8:x4}]", 7, -7, 0x7b), "[0007   ][   -0007][    007b]");
+
+    // numbers written across the end of the stack buffer of TAutoString
+    const std::string Prefix(FL_DEFAULT_AUTO_STRING_STACK_LENGTH - 3, '.');
+    EXPECT_EQ(StandardLibrary::Format("{0}{1,10}|{2,-10:x}|", Prefix.c_str(), 12345, 0xabc), Prefix + "     12345|abc       |");
+    EXPECT_EQ(StandardLibrary::Format("{0}{1:b}", Prefix.c_str(), -1), Prefix + std::string(32, '1'));
+}
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+TEST(Format, TestLengthHint)
+{
+    const char* const Text = "{0} hint {1}";
+    const std::string Long(FL_DEFAULT_AUTO_STRING_STACK_LENGTH * 2, 'x');
+
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(StandardLibrary::Format(Text, Long.c_str(), i), Long + " hint " + std::to_string(i));
+    }
+
+    typedef Details::StandardLibrary::STLGlobalPatternStorageA StorageType;
+    const StorageType::PatternListType* Patterns = StorageType::GetStorage()->LookupPatterns(
+        Text,
+        strlen(Text),
+        Details::CalculateByteArrayHash(reinterpret_cast<const uint8_t*>(Text), strlen(Text))
+        );
+
+    ASSERT_NE(Patterns, nullptr);
+    EXPECT_EQ(Patterns->GetLengthHint(), Long.length() + 7);
+
+    // compiled handles don't learn
+    const auto Compiled = StandardLibrary::Compile(Text);
+    EXPECT_EQ(StandardLibrary::Format(Compiled, "a", 1), "a hint 1");
+    EXPECT_EQ(Compiled.GetPatterns()->GetLengthHint(), 0U);
+}
+#endif
+
+TEST(Format, TestAppendFormat)
+{
+    std::string v = "header:";
+
+    StandardLibrary::AppendFormat(v, "{0},{1:x}", 100, 255);
+    EXPECT_EQ(v, "header:100,ff");
+
+    StandardLibrary::AppendFormat(v, "|no arguments|");
+    EXPECT_EQ(v, "header:100,ff|no arguments|");
+
+    StandardLibrary::AppendFormat(v, std::string("{0,4}"), "x");
+    EXPECT_EQ(v, "header:100,ff|no arguments|   x");
+
+    std::string Report;
+    std::string Expected;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        StandardLibrary::AppendFormat(Report, "line {0}: {1}\n", i, "text");
+        Expected += "line " + StandardLibrary::Format("{0}", i) + ": text\n";
+    }
+
+    EXPECT_EQ(Report, Expected);
+
+    std::wstring w = L"W";
+    StandardLibrary::AppendFormat(w, L"{0}-{1}", 1, L"2");
+    EXPECT_EQ(w, L"W1-2");
+
+    // escaped braces, invalid indices and a placeholder longer than the stack buffer of TAutoString
+    const std::string Large(500, 'z');
+    std::string Long = "head|";
+    StandardLibrary::AppendFormat(Long, "{{{0}}}{3}|{1}|{2,-6:d4}|", "a", Large, 7);
+    EXPECT_EQ(Long, "head|{a}{3}|" + Large + "|0007  |");
+}
+
+static std::string ReadAllText(FILE* file)
+{
+    std::string Text;
+    char Buffer[256];
+
+    rewind(file);
+
+    size_t Length;
+    while ((Length = fread(Buffer, 1, sizeof(Buffer), file)) > 0)
+    {
+        Text.append(Buffer, Length);
+    }
+
+    return Text;
+}
+
+TEST(Format, TestFileSink)
+{
+    FILE* File = tmpfile();
+    ASSERT_TRUE(File != nullptr);
+
+    std::string Expected;
+
+    {
+        // a small buffer makes the sink write several times
+        TFileSink<char> Sink(File, 64);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            StandardLibrary::FormatTo(Sink, "{0,4}:{1:x}\n", i, i);
+            Expected += StandardLibrary::Format("{0,4}:{1:x}\n", i, i);
+
+            EXPECT_LT(Sink.GetBuffer().GetLength(), Sink.GetBufferLength());
+        }
+
+        StandardLibrary::FormatTo(Sink, "end");
+        Sink.Write("!", 1);
+        Expected += "end!";
+
+        EXPECT_TRUE(Sink.Flush());
+        EXPECT_TRUE(Sink.GetBuffer().IsEmpty());
+    }
+
+    EXPECT_EQ(ReadAllText(File), Expected);
+
+    fclose(File);
+
+#if !FL_PLATFORM_WINDOWS
+    File = tmpfile();
+    ASSERT_TRUE(File != nullptr);
+
+    {
+        TFileSink<char> Sink(fileno(File));
+        StandardLibrary::FormatTo(Sink, "{0}-{1}", 1, "fd");
+    }
+
+    EXPECT_EQ(ReadAllText(File), "1-fd");
+
+    fclose(File);
+#endif
+}
+
+#if FL_WITH_MAPPED_FILE_SINK
+TEST(Format, TestMappedFileSink)
+{
+    char Path[] = "/tmp/FormatMappedFileSinkXXXXXX";
+    const int FileDescriptor = mkstemp(Path);
+    ASSERT_GE(FileDescriptor, 0);
+    close(FileDescriptor);
+
+    const int ThreadCount = 8;
+    const int LineCount = 2000;
+
+    {
+        // one page chunks, the writers roll over the chunks many times
+        TMappedFileSink<char> Sink(Path, 4096);
+        ASSERT_TRUE(Sink.IsValid());
+
+        std::vector<std::thread> Threads;
+
+        for (int t = 0; t < ThreadCount; ++t)
+        {
+            Threads.push_back(std::thread([&Sink, t]()
+            {
+                for (int i = 0; i < LineCount; ++i)
+                {
+                    EXPECT_TRUE(StandardLibrary::FormatTo(Sink, "{0}:{1,6}\n", t, i));
+                }
+            }));
+        }
+
+        for (size_t i = 0; i < Threads.size(); ++i)
+        {
+            Threads[i].join();
+        }
+    }
+
+    {
+        // reopen and append to the end
+        TMappedFileSink<char> Sink(Path);
+        EXPECT_TRUE(StandardLibrary::FormatTo(Sink, "{0}", "end"));
+    }
+
+    FILE* File = fopen(Path, "rb");
+    ASSERT_TRUE(File != nullptr);
+
+    std::vector<int> NextLine(ThreadCount, 0);
+    int Thread = 0;
+    int Line = 0;
+
+    while (fscanf(File, "%d:%d\n", &Thread, &Line) == 2)
+    {
+        ASSERT_TRUE(Thread >= 0 && Thread < ThreadCount);
+        EXPECT_EQ(NextLine[Thread], Line);
+        NextLine[Thread] = Line + 1;
+    }
+
+    char Tail[8] = { 0 };
+    EXPECT_EQ(fread(Tail, 1, sizeof(Tail), File), 3u);
+    EXPECT_STREQ(Tail, "end");
+
+    fclose(File);
+    remove(Path);
+
+    for (int t = 0; t < ThreadCount; ++t)
+    {
+        EXPECT_EQ(NextLine[t], LineCount);
+    }
+}
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+TEST(Format, TestScatterOutput)
+{
+    static const char Template[] =
+        "<html><head><title>{0}</title></head>"
+        "<body><p>count = {1,6}, ratio = {2:f2}{{ok}}</p></body></html>";
+
+    TScatterOutput<char> Sink;
+    StandardLibrary::FormatTo(Sink, Template, "Report", 42, 0.5);
+
+    const std::string Expected = StandardLibrary::Format(Template, "Report", 42, 0.5);
+
+    TAutoString<char> Text;
+    Sink.CopyTo(Text);
+    EXPECT_EQ(std::string(Text.CStr(), Text.GetLength()), Expected);
+    EXPECT_EQ(Sink.GetLength(), Expected.size());
+
+    // the long literal segments point into the template
+    EXPECT_TRUE(Sink.GetSegmentData(0) == Template);
+    EXPECT_EQ(Sink.GetSegmentLength(0), strlen("<html><head><title>"));
+
+    size_t LiteralBytes = 0;
+
+    for (size_t i = 0; i < Sink.GetSegmentCount(); ++i)
+    {
+        const char* Data = Sink.GetSegmentData(i);
+
+        if (Data >= Template && Data < Template + sizeof(Template))
+        {
+            LiteralBytes += Sink.GetSegmentLength(i);
+        }
+    }
+
+    EXPECT_GT(LiteralBytes, Expected.size() / 2);
+
+    // appending keeps the previous segments
+    StandardLibrary::FormatTo(Sink, "{0}", 1);
+    EXPECT_EQ(Sink.GetLength(), Expected.size() + 1);
+
+    Sink.Clear();
+    EXPECT_EQ(Sink.GetSegmentCount(), 0u);
+
+#if !FL_PLATFORM_WINDOWS
+    StandardLibrary::FormatTo(Sink, Template, "Report", 42, 0.5);
+
+    FILE* File = tmpfile();
+    ASSERT_TRUE(File != nullptr);
+
+    EXPECT_TRUE(Sink.WriteTo(fileno(File)));
+    EXPECT_EQ(ReadAllText(File), Expected);
+
+    fclose(File);
+#endif
+}
+#endif
+
+TEST(Format, TestChunkedString)
+{
+    // small blocks, most lines cross a block boundary
+    TChunkedString<char> Sink(7);
+    std::string Expected;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        StandardLibrary::FormatTo(Sink, "{0}:{1,5}|", i, "abc");
+        Expected += StandardLibrary::Format("{0}:{1,5}|", i, "abc");
+    }
+
+    StandardLibrary::FormatTo(Sink, "end");
+    Expected += "end";
+
+    ASSERT_EQ(Sink.GetLength(), Expected.size());
+    EXPECT_EQ(Sink.GetBlockCount(), (Expected.size() + 6) / 7);
+
+    std::string Text(Sink.GetLength(), ' ');
+    Sink.CopyTo(&Text[0]);
+    EXPECT_EQ(Text, Expected);
+
+    std::string Blocks;
+    for (size_t i = 0; i < Sink.GetBlockCount(); ++i)
+    {
+        Blocks.append(Sink.GetBlockData(i), Sink.GetBlockLength(i));
+    }
+    EXPECT_EQ(Blocks, Expected);
+
+    // the blocks are reused after Clear
+    const char* FirstBlock = Sink.GetBlockData(0);
+    Sink.Clear();
+    EXPECT_TRUE(Sink.IsEmpty());
+
+    StandardLibrary::FormatTo(Sink, "{0}", 12345678);
+    EXPECT_TRUE(Sink.GetBlockData(0) == FirstBlock);
+    EXPECT_EQ(Sink.GetBlockLength(1), 1u);
+
+    FILE* File = tmpfile();
+    ASSERT_TRUE(File != nullptr);
+    EXPECT_TRUE(Sink.WriteTo(File));
+    EXPECT_EQ(ReadAllText(File), "12345678");
+    fclose(File);
+}
+
+TEST(Format, TestChunkedStringLargeArgument)
+{
+    TChunkedString<char> Sink(64);
+
+    // one argument is several blocks long, the literal text around it crosses the block boundaries too
+    const std::string Large(1000, 'x');
+    StandardLibrary::FormatTo(Sink, "{{begin}} {0} {1,-70}|{2:x8} {{end}}", 1, Large, 255);
+
+    const std::string Expected = StandardLibrary::Format("{{begin}} {0} {1,-70}|{2:x8} {{end}}", 1, Large, 255);
+
+    ASSERT_EQ(Sink.GetLength(), Expected.size());
+    EXPECT_EQ(Sink.GetBlockCount(), (Expected.size() + 63) / 64);
+
+    std::string Text(Sink.GetLength(), ' ');
+    Sink.CopyTo(&Text[0]);
+    EXPECT_EQ(Text, Expected);
+
+    // the blocks of the reserved length are allocated up front
+    Sink.Clear();
+    Sink.Reserve(200);
+    const size_t ReservedBlocks = (200 + 63) / 64;
+    EXPECT_EQ(Sink.GetLength(), 0u);
+
+    StandardLibrary::FormatTo(Sink, "{0}", std::string(200, 'y'));
+    EXPECT_EQ(Sink.GetBlockCount(), ReservedBlocks);
+
+    TChunkedString<wchar_t> SinkW(5);
+    StandardLibrary::FormatTo(SinkW, L"[{0}] {1,12}", std::wstring(23, L'w'), 3.5);
+
+    std::wstring TextW(SinkW.GetLength(), L' ');
+    SinkW.CopyTo(&TextW[0]);
+    EXPECT_EQ(TextW, L"[" + std::wstring(23, L'w') + L"]         3.50");
+}
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+static void RunAsyncFileWriter(const EBackPressure policy, const size_t bufferCount, std::string& text, size_t& droppedLength)
+{
+    FILE* File = tmpfile();
+    ASSERT_TRUE(File != nullptr);
+
+    {
+        // small buffers, the producers hand over many buffers
+        TAsyncFileWriter<char> Writer(File, policy, 64, bufferCount);
+        std::vector<std::thread> Threads;
+
+        for (int t = 0; t < 4; ++t)
+        {
+            Threads.push_back(std::thread([&Writer, t]()
+            {
+                TAsyncFileProducer<char> Producer(Writer);
+
+                for (int i = 0; i < 1000; ++i)
+                {
+                    StandardLibrary::FormatTo(Producer, "{0}:{1,6}\n", t, i);
+                }
+            }));
+        }
+
+        for (size_t i = 0; i < Threads.size(); ++i)
+        {
+            Threads[i].join();
+        }
+
+        EXPECT_FALSE(Writer.HasError());
+
+        if (policy == EBackPressure::Block)
+        {
+            // every producer may own one buffer beyond the limit
+            EXPECT_LE(Writer.GetAllocatedBufferCount(), bufferCount + Threads.size());
+        }
+
+        droppedLength = Writer.GetDroppedLength();
+    }
+
+    text = ReadAllText(File);
+
+    fclose(File);
+}
+
+TEST(Format, TestAsyncFileWriter)
+{
+    const EBackPressure Policies[] = { EBackPressure::Block, EBackPressure::Grow, EBackPressure::Drop };
+
+    for (size_t p = 0; p < FL_ARRAY_COUNTOF(Policies); ++p)
+    {
+        std::string Text;
+        size_t DroppedLength = 0;
+
+        RunAsyncFileWriter(Policies[p], 5, Text, DroppedLength);
+
+        // the lines of one producer keep their order, a dropped range only removes whole lines
+        std::vector<int> NextLine(4, 0);
+        size_t Lines = 0;
+        size_t Start = 0;
+
+        while (Start < Text.size())
+        {
+            const size_t End = Text.find('\n', Start);
+            ASSERT_NE(End, std::string::npos);
+
+            int Thread = -1;
+            int Line = -1;
+            ASSERT_EQ(sscanf(Text.c_str() + Start, "%d:%d", &Thread, &Line), 2);
+            ASSERT_TRUE(Thread >= 0 && Thread < 4);
+
+            if (Policies[p] == EBackPressure::Drop)
+            {
+                EXPECT_GE(Line, NextLine[Thread]);
+            }
+            else
+            {
+                EXPECT_EQ(Line, NextLine[Thread]);
+            }
+
+            NextLine[Thread] = Line + 1;
+            ++Lines;
+            Start = End + 1;
+        }
+
+        EXPECT_EQ(Lines * 9 + DroppedLength, 4000u * 9);
+
+        if (Policies[p] != EBackPressure::Drop)
+        {
+            EXPECT_EQ(DroppedLength, 0u);
+        }
+    }
+}
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+struct LazyCounter
+{
+    mutable int Count;
+};
+
+namespace Formatting
+{
+    namespace Details
+    {
+        template <typename TCharType>
+        class TTranslator< TCharType, LazyCounter > : public TTranslatorBase< TCharType, LazyCounter >
+        {
+        public:
+            typedef TTranslatorBase< TCharType, LazyCounter > Super;
+
+            static bool Transfer(typename Super::StringType& s, const typename Super::FormatPattern& /*pattern*/, const LazyCounter& arg)
+            {
+                ++arg.Count;
+                s.AddChar('#');
+
+                return true;
+            }
+        };
+    }
+}
+
+TEST(Format, TestLazyFormat)
+{
+    LazyCounter Counter = { 0 };
+    const std::string Name = "lazy";
+
+    {
+        // nothing is rendered if the value is not consumed
+        const auto Message = StandardLibrary::Lazy("{0} {1} {2:x}", Counter, Name, 255);
+        (void)Message;
+    }
+    EXPECT_EQ(Counter.Count, 0);
+
+    const auto Message = StandardLibrary::Lazy("{0} {1} {2:x}", Counter, Name, 255);
+    EXPECT_EQ(StandardLibrary::Format(Message), "# lazy ff");
+    EXPECT_EQ(Counter.Count, 1);
+
+    std::string Text = "text:";
+    StandardLibrary::AppendFormat(Text, Message);
+    EXPECT_EQ(Text, "text:# lazy ff");
+
+    StandardLibrary::FormatTo(Text, Message);
+    EXPECT_EQ(Text, "# lazy ff");
+
+    StandardLibrary::AppendFormat(Text, StandardLibrary::Lazy("|{{{0}}}{1}", 5));
+    EXPECT_EQ(Text, "# lazy ff|{5}{1}");
+
+    std::ostringstream Stream;
+    Stream << Message << "|" << StandardLibrary::Lazy("no arguments");
+    EXPECT_EQ(Stream.str(), "# lazy ff|no arguments");
+    EXPECT_EQ(Counter.Count, 4);
+
+    TAutoString<char> Sink;
+    StandardLibrary::Lazy(std::string("{1}-{0}"), 1, 2).AppendTo(Sink);
+    EXPECT_STREQ(Sink.CStr(), "2-1");
+
+    EXPECT_EQ(StandardLibrary::Format(StandardLibrary::Lazy(L"{0}", 3)), L"3");
+}
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+TEST(Format, TestFormatReader)
+{
+    const std::string Name = "reader";
+    const char* Format = "<{0,10}>[{1}]{{{2:x}}} the end of the format";
+    const std::string Expected = StandardLibrary::Format(Format, Name, 3.5, 255);
+
+    // every chunk size must give the same text, including stops in the middle of a placeholder
+    for (size_t ChunkSize = 1; ChunkSize <= Expected.size() + 1; ++ChunkSize)
+    {
+        auto Reader = StandardLibrary::MakeReader(StandardLibrary::Lazy(Format, Name, 3.5, 255));
+
+        std::string Text;
+        char Buffer[64];
+        size_t Length;
+
+        while ((Length = Reader.Read(Buffer, ChunkSize)) > 0)
+        {
+            EXPECT_TRUE(Length == ChunkSize || Reader.IsEnd());
+            Text.append(Buffer, Length);
+        }
+
+        EXPECT_TRUE(Reader.IsEnd());
+        EXPECT_EQ(Text, Expected);
+    }
+
+    auto Reader = StandardLibrary::MakeReader(StandardLibrary::Lazy(L"no arguments"));
+    wchar_t Buffer[8];
+    EXPECT_EQ(Reader.Read(Buffer, 8), 8u);
+    EXPECT_EQ(Reader.Read(Buffer, 8), 4u);
+    EXPECT_EQ(std::wstring(Buffer, 4), L"ents");
+    EXPECT_EQ(Reader.Read(Buffer, 8), 0u);
+}
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+TEST(Format, TestFormatBatchParallel)
+{
+    std::vector<std::string> Names;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        Names.push_back(StandardLibrary::Format("name{0}", i));
+    }
+
+    const size_t RecordCount = 10007;
+    std::string Expected = "header\n";
+
+    for (size_t i = 0; i < RecordCount; ++i)
+    {
+        Expected += StandardLibrary::Format("{0},{1},{2:f2}\n", i, Names[i % Names.size()], i * 0.5);
+    }
+
+    const size_t ThreadCounts[] = { 0, 1, 2, 3, 8 };
+
+    for (size_t t = 0; t < FL_ARRAY_COUNTOF(ThreadCounts); ++t)
+    {
+        std::string Text = "header\n";
+
+        StandardLibrary::FormatBatchParallel(Text, "{0},{1},{2:f2}\n", RecordCount, [&Names](const size_t index)
+        {
+            return std::tuple<size_t, const std::string&, double>(index, Names[index % Names.size()], index * 0.5);
+        }, ThreadCounts[t]);
+
+        EXPECT_EQ(Text, Expected);
+    }
+
+    std::wstring Empty;
+    StandardLibrary::FormatBatchParallel(Empty, std::wstring(L"-"), 3, [](size_t) { return std::tuple<>(); });
+    EXPECT_EQ(Empty, L"---");
+}
+#endif
+
+TEST(Format, TestFormatJoin)
+{
+    std::vector<int32_t> values;
+    values.push_back(1);
+    values.push_back(-20);
+    values.push_back(300);
+
+    EXPECT_EQ(StandardLibrary::FormatJoin("{0}", values, ","), "1,-20,300");
+    EXPECT_EQ(StandardLibrary::FormatJoin("{0:x8}", values, ", "), "00000001, -00000014, 0000012c");
+    EXPECT_EQ(StandardLibrary::FormatJoin("[{0,4}]", values, ""), "[   1][ -20][ 300]");
+    EXPECT_EQ(StandardLibrary::FormatJoin(L"{0}", values, L";"), L"1;-20;300");
+
+    const double numbers[] = { 1.5, 2.25, 3.125 };
+    EXPECT_EQ(StandardLibrary::FormatJoin("{0:f3}", numbers, FL_ARRAY_COUNTOF(numbers), " | "), "1.500 | 2.250 | 3.125");
+
+    std::vector<std::string> texts;
+    texts.push_back("a");
+    texts.push_back("bc");
+    EXPECT_EQ(StandardLibrary::FormatJoin("'{0}'", texts, ","), "'a','bc'");
+
+    EXPECT_EQ(StandardLibrary::FormatJoin("{0}", std::vector<int>(), ","), "");
+    EXPECT_EQ(StandardLibrary::FormatJoin("none", values, ","), "none,none,none");
+
+    std::string sink = "dirty";
+    StandardLibrary::FormatJoinTo(sink, "{0:X}", values, "-");
+    EXPECT_EQ(sink, "1--14-12C");
+}
+
+TEST(Format, TestLongLiteralFormat)
+{
+    EXPECT_EQ(
+        StandardLibrary::Format("a long literal prefix without placeholders, then {0} and {{escaped}} and more literal text {1,5}|", 12, "xy"),
+        "a long literal prefix without placeholders, then 12 and {escaped} and more literal text    xy|"
+        );
+
+    EXPECT_EQ(
+        StandardLibrary::Format(L"{0}-0123456789abcdefghijklmnopqrstuvwxyz-{1}", 1, 2),
+        L"1-0123456789abcdefghijklmnopqrstuvwxyz-2"
+        );
+
+    // formats without curly braces are copied verbatim
+    const std::string Plain(300, 'p');
+    EXPECT_EQ(StandardLibrary::Format(Plain.c_str()), Plain);
+    EXPECT_EQ(StandardLibrary::Format(Plain, 1, 2), Plain);
+    EXPECT_EQ(StandardLibrary::Format(L"plain text"), L"plain text");
+    EXPECT_EQ(StandardLibrary::Format(""), "");
+}
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+TEST(Format, TestFormatOnce)
+{
+    EXPECT_EQ(StandardLibrary::FormatOnce("{0}--#--{1,8}--#--{2}", 100, -40.2f, " String "), "100--#--  -40.20--#-- String ");
+    EXPECT_EQ(StandardLibrary::FormatOnce("{{{0:x8}}} {1} {5}", 123, std::string("str")), "{0000007b} str {5}");
+    EXPECT_EQ(StandardLibrary::FormatOnce(L"{1}{0}", L"a", 2), L"2a");
+    EXPECT_EQ(StandardLibrary::FormatOnce("no parameter"), "no parameter");
+    EXPECT_EQ(StandardLibrary::FormatOnce(std::string("{0,-4}|"), 'c'), "c   |");
+
+    std::wstring sink = L"dirty";
+    StandardLibrary::FormatOnceTo(sink, L"{0:f2}", 3.14159);
+    EXPECT_EQ(sink, L"3.14");
+
+    // long formats are cached unless FL_STREAMING_FORMAT_LENGTH opts in to the single pass path, the result must be the same
+    std::string LongFormat(1024, '-');
+    LongFormat += "{0} {1:X}";
+
+    EXPECT_EQ(StandardLibrary::Format(LongFormat, 1, 255), std::string(1024, '-') + "1 FF");
+    EXPECT_EQ(StandardLibrary::Format(LongFormat, 1, 255), StandardLibrary::FormatOnce(LongFormat, 1, 255));
+
+#if FL_STREAMING_FORMAT_LENGTH > 0
+    // built by UnitTestsStreaming, the formats from this length on take the single pass path automatically
+    std::string StreamedFormat(FL_STREAMING_FORMAT_LENGTH, '=');
+    StreamedFormat += "{1}|{0,4}";
+
+    EXPECT_EQ(StandardLibrary::Format(StreamedFormat, 7, "x"), std::string(FL_STREAMING_FORMAT_LENGTH, '=') + "x|   7");
+    EXPECT_EQ(StandardLibrary::Format(StandardLibrary::Lazy(StreamedFormat, 7, "x")), StandardLibrary::FormatOnce(StreamedFormat, 7, "x"));
+#endif
+}
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX11
+TEST(Format, TestCompiledFormat)
+{
+    std::string Text = "{0}--#--{1,8}--#--{2:x4}";
+    const auto Compiled = StandardLibrary::Compile(Text);
+
+    // the handle owns its copy of the text
+    Text = "changed";
+
+    EXPECT_EQ(StandardLibrary::Format(Compiled, 100, "abc", 255), "100--#--     abc--#--00ff");
+    EXPECT_EQ(StandardLibrary::Format(Compiled, -1, "x", 16), "-1--#--       x--#--0010");
+
+    const auto Copied = Compiled;
+    EXPECT_EQ(StandardLibrary::Format(Copied, 1, 2, 3), "1--#--       2--#--0003");
+
+    std::string Sink = "dirty";
+    StandardLibrary::FormatTo(Sink, Compiled, 7, 8, 9);
+    EXPECT_EQ(Sink, "7--#--       8--#--0009");
+
+    const auto CompiledW = StandardLibrary::Compile(L"{{{0}}}");
+    EXPECT_EQ(StandardLibrary::Format(CompiledW), L"{{0}}");
+    EXPECT_EQ(StandardLibrary::Format(CompiledW, 5), L"{5}");
+
+    std::wstring SinkW;
+    StandardLibrary::FormatTo(SinkW, CompiledW, L"w");
+    EXPECT_EQ(SinkW, L"{w}");
+}
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX20
+TEST(Format, TestCompiledLiteralFormat)
+{
+    EXPECT_EQ(StandardLibrary::Format(FL_COMPILED_FORMAT("{0} - {1,8:f2}"), "abc", 3.14159), "abc -     3.14");
+    EXPECT_EQ(StandardLibrary::Format(FL_COMPILED_FORMAT("{{{0,-4}}}|{1:X4}|{2}"), 7, 255), "{7   }|00FF|{2}");
+    EXPECT_EQ(StandardLibrary::Format(FL_COMPILED_FORMAT("no parameters")), "no parameters");
+
+    // compile time patterns must be the same as the runtime ones
+    EXPECT_EQ(
+        StandardLibrary::Format(FL_COMPILED_FORMAT("{0:d5}-{0:x}-{1:e3}-{2}-{x}-{3,5:b}"), -42, 1234.5, std::string("str"), 5),
+        StandardLibrary::Format("{0:d5}-{0:x}-{1:e3}-{2}-{x}-{3,5:b}", -42, 1234.5, std::string("str"), 5)
+        );
+
+    std::string Sink = "dirty";
+    StandardLibrary::FormatTo(Sink, FL_COMPILED_FORMAT("{1}{0}"), 1, 2);
+    EXPECT_EQ(Sink, "21");
+
+    std::wstring SinkW;
+    StandardLibrary::FormatTo(SinkW, FL_COMPILED_FORMAT(L"[{0,5}]"), L"w");
+    EXPECT_EQ(SinkW, L"[    w]");
+}
+#endif
+
+#if FL_COMPILER_IS_GREATER_THAN_CXX20
+TEST(Format, TestConstantFormat)
+{
+    constexpr auto Name = FL_CONSTANT_FORMAT("svc.{0}.latency", 42);
+    static_assert(Name.size() == 15 && Name[4] == '4' && Name[14] == 0);
+    EXPECT_STREQ(Name.data(), "svc.42.latency");
+
+    constexpr auto Plain = FL_CONSTANT_FORMAT("{{v}} {1}");
+    EXPECT_STREQ(Plain.data(), "{v} {1}");
+
+    // same as the runtime translators
+    constexpr auto Mixed = FL_CONSTANT_FORMAT("{0,5}|{1,-6}|{2:X4}|{3:d6}|{4:b}|{5}|{6:x}|{7:p}", "ab", true, 255, -42, (short)-1, 'c', INT_MIN, 3);
+    EXPECT_EQ(
+        std::string(Mixed.data()),
+        StandardLibrary::Format("{0,5}|{1,-6}|{2:X4}|{3:d6}|{4:b}|{5}|{6:x}|{7:p}", "ab", true, 255, -42, (short)-1, 'c', INT_MIN, 3)
+        );
+
+    constexpr auto Wide = FL_CONSTANT_FORMAT(L"{0}-{1,3}", L"w", 7U);
+    EXPECT_STREQ(Wide.data(), L"w-  7");
+}
+#endif
+
 TEST(Format, TestMultipleDifferentArgsWChar)
 {
     int a = 123;